@@ -0,0 +1,461 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+/*!
+* SDK基准测试 \n
+* 用合成的GS2数据流测试数据包解析、角度换算、::ascendScanData、
+* ::CYdLidar::doProcessSimple 滤波以及从录制数据到::LaserScan 的完整流程,
+* 输出吞吐量(packets/s)、每个点耗时(ns/point)和每帧内存分配次数(allocs/scan)
+*/
+#include "CYdLidar.h"
+#define YDLIDAR_TEST_COUNT_ALLOCATIONS
+#include "test/test_stream.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#if !defined(_WIN32)
+#include <time.h>
+#endif
+using namespace ydlidar;
+
+namespace {
+
+volatile double sink = 0;               ///< 防止换算结果被优化掉
+
+/*!
+* 单次测试结果
+*/
+struct BenchResult {
+  std::string name;
+  uint64_t packets;       ///< 处理的数据包数
+  uint64_t points;        ///< 处理的点数
+  uint64_t ns;            ///< 耗时
+  double   allocs;        ///< 每帧内存分配次数, 负数表示不统计
+};
+
+uint64_t wallNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// 当前线程CPU时间, 不包含阻塞等待
+uint64_t threadNs() {
+#if defined(_WIN32)
+  return wallNs();
+#else
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+/*!
+* 开放解析接口的驱动
+*/
+class BenchDriver : public YDlidarDriver {
+ public:
+  using YDlidarDriver::waitScanData;
+  using YDlidarDriver::angTransform;
+};
+
+/// 数据包解析: 录制数据 -> ::waitScanData
+BenchResult benchDecode(const std::string &path, uint64_t packets,
+                        std::vector<GS2Point> &decoded) {
+  BenchResult result = {"decode(waitScanData)", 0, 0, 0, -1};
+  BenchDriver driver;
+  ReplaySerial *serial = new ReplaySerial(path, 0);
+  driver.setSerial(serial, true);
+
+  if (!serial->open()) {
+    fprintf(stderr, "failed to open %s\n", path.c_str());
+    return result;
+  }
+
+  driver.isConnected = true;
+  gs_device_para para;
+
+  if (!IS_OK(driver.getDevicePara(para, 1000))) {
+    fprintf(stderr, "failed to read device parameters\n");
+    return result;
+  }
+
+  GS2Point nodes[PackageSampleMaxLngth_GS];
+  uint64_t start = wallNs();
+
+  while (result.packets < packets) {
+    size_t count = PackageSampleMaxLngth_GS;
+
+    if (!IS_OK(driver.waitScanData(nodes, count, 100))) {
+      break;
+    }
+
+    if (decoded.size() < 64 * PackageSampleMaxLngth_GS) {
+      decoded.insert(decoded.end(), nodes, nodes + count);
+    }
+
+    result.packets++;
+    result.points += count;
+  }
+
+  result.ns = wallNs() - start;
+  driver.isConnected = false;
+  return result;
+}
+
+/// 角度距离换算: ::angTransform
+BenchResult benchAngTransform(uint64_t packets) {
+  BenchResult result = {"angTransform", 0, 0, 0, -1};
+  BenchDriver driver;
+  double theta = 0;
+  uint16_t dist = 0;
+  double sum = 0;
+  uint64_t start = wallNs();
+
+  for (uint64_t p = 0; p < packets; ++p) {
+    for (int n = 0; n < PackageSampleMaxLngth_GS; ++n) {
+      driver.angTransform(0, 150 + (p + n) % 300, n, &theta, &dist);
+      sum += theta + dist;
+    }
+  }
+
+  result.ns = wallNs() - start;
+  result.packets = packets;
+  result.points = packets * PackageSampleMaxLngth_GS;
+  sink = sum;
+  return result;
+}
+
+/// 批量换算: ::batchTransform
+BenchResult benchBatchTransform(const std::vector<gs2_node_package> &packages,
+                                uint64_t packets) {
+  BenchResult result = {std::string("batchTransform(") +
+                        transformISAToString(getBatchTransformISA()) + ")", 0, 0, 0, -1
+                       };
+  GS2TransformTable table;
+
+  for (int n = 0; n < PackageSampleMaxLngth_GS; ++n) {
+    table.k[n] = tan((n - 80) * 0.4 * M_PI / 180);
+    table.c[n] = n < 80 ? -Angle_Py : Angle_Py;
+  }
+
+  float theta[PackageSampleMaxLngth_GS];
+  float dist[PackageSampleMaxLngth_GS];
+  double sum = 0;
+  uint64_t start = wallNs();
+
+  for (uint64_t p = 0; p < packets; ++p) {
+    batchTransform(packages[p % packages.size()].packageSample, table, theta, dist);
+    sum += theta[p % PackageSampleMaxLngth_GS] + dist[0];
+  }
+
+  result.ns = wallNs() - start;
+  result.packets = packets;
+  result.points = packets * PackageSampleMaxLngth_GS;
+  sink = sum;
+  return result;
+}
+
+/// 补全无效点角度: ::ascendScanData
+BenchResult benchAscend(const std::vector<GS2Point> &decoded, uint64_t packets) {
+  BenchResult result = {"ascendScanData", 0, 0, 0, -1};
+  size_t packages = decoded.size() / PackageSampleMaxLngth_GS;
+
+  if (!packages) {
+    return result;
+  }
+
+  YDlidarDriver driver;
+  ModuleFrame frame;
+  node_info nodes[PackageSampleMaxLngth_GS];
+  uint64_t elapsed = 0;
+  memset(&frame, 0, sizeof(frame));
+  frame.count = PackageSampleMaxLngth_GS;
+
+  for (uint64_t p = 0; p < packets; ++p) {
+    memcpy(frame.points, &decoded[(p % packages) * PackageSampleMaxLngth_GS],
+           sizeof(frame.points));
+    YDlidarDriver::toNodeInfo(frame, nodes, PackageSampleMaxLngth_GS);
+    uint64_t start = wallNs();
+    driver.ascendScanData(nodes, PackageSampleMaxLngth_GS);
+    elapsed += wallNs() - start;
+  }
+
+  result.ns = elapsed;
+  result.packets = packets;
+  result.points = packets * PackageSampleMaxLngth_GS;
+  return result;
+}
+
+/// 运动畸变校正: ::deskewPoints
+BenchResult benchDeskew(uint64_t packets) {
+  BenchResult result = {"deskewPoints", 0, 0, 0, -1};
+  std::vector<LaserPoint> points(PackageSampleMaxLngth_GS);
+  std::vector<float> offsets(PackageSampleMaxLngth_GS);
+  DeskewMotion motion = {500, 100, 1.0f};
+  double sum = 0;
+  uint64_t elapsed = 0;
+
+  for (uint64_t p = 0; p < packets; ++p) {
+    for (int n = 0; n < PackageSampleMaxLngth_GS; ++n) {
+      points[n].angle = (n - 80) * 0.4 * M_PI / 180;
+      points[n].range = 100 + (p + n) % 900;
+      offsets[n] = n * 0.0002f;
+    }
+
+    uint8_t *base = reinterpret_cast<uint8_t *>(&points[0]);
+    uint64_t start = wallNs();
+    deskewPoints(base + offsetof(LaserPoint, angle),
+                 base + offsetof(LaserPoint, range), sizeof(LaserPoint),
+                 &offsets[0], points.size(), motion);
+    elapsed += wallNs() - start;
+    sum += points[p % PackageSampleMaxLngth_GS].range;
+  }
+
+  result.ns = elapsed;
+  result.packets = packets;
+  result.points = packets * PackageSampleMaxLngth_GS;
+  sink = sum;
+  return result;
+}
+
+/// 匀速直线运动的位姿, 用于测试::DESKEW_POSE
+bool benchPose(uint64_t stamp, LidarPose2D *pose, void *) {
+  double t = (stamp % 1000000000000ULL) / 1e9;
+  pose->x = 0.5 * t;
+  pose->y = 0;
+  pose->theta = 0.2 * t;
+  return true;
+}
+
+/*!
+* @brief 回放录制数据到::CYdLidar
+* @param[out] filter 只统计::CYdLidar::doProcessSimple 在当前线程的CPU时间和内存分配
+* @param[out] full   从::CYdLidar::initialize 到最后一帧的总时间
+* @param[in]  deskew 是否开启::DESKEW_POSE 运动畸变校正
+*/
+template <typename ScanType>
+void benchLidar(const std::string &path, uint64_t packets, const char *name,
+                BenchResult &filter, BenchResult &full, bool deskew = false) {
+  std::string suffix = deskew ? "+deskew" : "";
+  filter.name = std::string("doProcessSimple(") + name + ")" + suffix;
+  full.name = std::string("record->") + name + suffix;
+  filter.packets = filter.points = filter.ns = 0;
+  full.packets = full.points = full.ns = 0;
+  filter.allocs = full.allocs = -1;
+
+  CYdLidar laser;
+  laser.setSerialBaudrate(test::Baudrate);
+  laser.setReplayFile(path);
+  laser.setReplaySpeed(0);
+  laser.setFixedResolution(false);
+  laser.setAutoReconnect(false);
+  laser.setIntensity(true);
+  laser.setMaxAngle(160);
+  laser.setMinAngle(-150);
+  laser.setMinRange(30);
+  laser.setMaxRange(1000);
+  std::vector<float> ignore;
+  ignore.push_back(10);
+  ignore.push_back(30);
+  ignore.push_back(-100);
+  ignore.push_back(-90);
+  laser.setIgnoreArray(ignore);
+
+  if (deskew) {
+    laser.setDeskewMode(DESKEW_POSE);
+    laser.setDeskewPoseCallback(benchPose, NULL);
+  }
+
+  uint64_t start = wallNs();
+
+  if (!laser.initialize() || !laser.turnOn()) {
+    fprintf(stderr, "failed to replay %s\n", path.c_str());
+    return;
+  }
+
+  ScanType scan;
+  bool hardError;
+  uint64_t last = start;
+  uint64_t allocs = 0;
+
+  while (filter.packets < packets) {
+    test::allocations = 0;
+    test::countAllocations = true;
+    uint64_t begin = threadNs();
+    bool ret = laser.doProcessSimple(scan, hardError);
+    uint64_t elapsed = threadNs() - begin;
+    test::countAllocations = false;
+
+    if (!ret) {
+      break;
+    }
+
+    filter.ns += elapsed;
+    last = wallNs();
+
+    //首帧分配输出缓存, 不计入
+    if (filter.packets) {
+      allocs += test::allocations;
+    }
+
+    filter.packets++;
+  }
+
+  laser.turnOff();
+  laser.disconnecting();
+
+  filter.points = filter.packets * PackageSampleMaxLngth_GS;
+  filter.allocs = filter.packets > 1 ? double(allocs) / (filter.packets - 1) : 0;
+  full.packets = filter.packets;
+  full.points = filter.points;
+  full.ns = last - start;
+}
+
+void printResult(const BenchResult &result) {
+  double seconds = result.ns / 1e9;
+  printf("%-36s %10llu %10.1f %12.0f %10.2f", result.name.c_str(),
+         (unsigned long long)result.packets, result.ns / 1e6,
+         seconds > 0 ? result.packets / seconds : 0.0,
+         result.points ? double(result.ns) / result.points : 0.0);
+
+  if (result.allocs >= 0) {
+    printf(" %12.2f", result.allocs);
+  } else {
+    printf(" %12s", "-");
+  }
+
+  printf("\n");
+}
+
+void usage(const char *name) {
+  fprintf(stderr,
+          "Usage: %s [-n packets] [-f recording]\n"
+          "  -n packets    number of synthetic packets (default 30000)\n"
+          "  -f recording  replay a SerialRecorder capture through CYdLidar\n"
+          "                instead of the synthetic stream\n",
+          name);
+}
+
+}
+
+int main(int argc, char *argv[]) {
+  uint64_t packets = 30000;
+  std::string recording;
+
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+      packets = strtoull(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "-f") && i + 1 < argc) {
+      recording = argv[++i];
+    } else {
+      usage(argv[0]);
+      return strcmp(argv[i], "-h") ? 1 : 0;
+    }
+  }
+
+  if (!packets) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  //合成数据: 三个模组轮流发送
+  std::vector<gs2_node_package> packages;
+  test::makePackages(packages, packets);
+
+  //数据包解析: 标定参数 + 数据包
+  std::vector<uint8_t> stream;
+  test::appendDevicePara(stream);
+  test::appendPackages(stream, packages);
+  std::string decodePath = "ydlidar_bench_decode.rec";
+
+  //CYdLidar: 完整的开启扫描数据流
+  std::string lidarPath = recording;
+
+  if (recording.empty()) {
+    lidarPath = "ydlidar_bench_lidar.rec";
+    std::vector<uint8_t> lidar;
+    test::appendLidarStream(lidar, packages);
+
+    if (!test::writeRecording(lidarPath, lidar)) {
+      fprintf(stderr, "failed to write %s\n", lidarPath.c_str());
+      return 1;
+    }
+  }
+
+  if (!test::writeRecording(decodePath, stream)) {
+    fprintf(stderr, "failed to write %s\n", decodePath.c_str());
+    return 1;
+  }
+
+  std::vector<BenchResult> results;
+  std::vector<GS2Point> decoded;
+  results.push_back(benchDecode(decodePath, packets, decoded));
+  results.push_back(benchAngTransform(packets));
+  results.push_back(benchBatchTransform(packages, packets));
+  results.push_back(benchAscend(decoded, packets));
+  results.push_back(benchDeskew(packets));
+
+  BenchResult filter, full;
+  benchLidar<LaserScan>(lidarPath, packets, "LaserScan", filter, full);
+  results.push_back(filter);
+  results.push_back(full);
+  benchLidar<LaserScanArrays>(lidarPath, packets, "LaserScanArrays", filter, full);
+  results.push_back(filter);
+  results.push_back(full);
+  benchLidar<LaserScanCartesian>(lidarPath, packets, "LaserScanCartesian", filter,
+                                 full);
+  results.push_back(filter);
+  results.push_back(full);
+  benchLidar<LaserScan>(lidarPath, packets, "LaserScan", filter, full, true);
+  results.push_back(filter);
+  results.push_back(full);
+
+  remove(decodePath.c_str());
+
+  if (recording.empty()) {
+    remove(lidarPath.c_str());
+  }
+
+  printf("\n%-36s %10s %10s %12s %10s %12s\n", "benchmark", "packets", "ms",
+         "packets/s", "ns/point", "allocs/scan");
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    printResult(results[i]);
+  }
+
+  return 0;
+}
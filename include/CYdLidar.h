@@ -1,682 +1,917 @@
-﻿/*********************************************************************
-* Software License Agreement (BSD License)
-*
-*  Copyright (c) 2018, EAIBOT, Inc.
-*  All rights reserved.
-*
-*  Redistribution and use in source and binary forms, with or without
-*  modification, are permitted provided that the following conditions
-*  are met:
-*
-*   * Redistributions of source code must retain the above copyright
-*     notice, this list of conditions and the following disclaimer.
-*   * Redistributions in binary form must reproduce the above
-*     copyright notice, this list of conditions and the following
-*     disclaimer in the documentation and/or other materials provided
-*     with the distribution.
-*   * Neither the name of the Willow Garage nor the names of its
-*     contributors may be used to endorse or promote products derived
-*     from this software without specific prior written permission.
-*
-*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
-*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
-*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
-*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
-*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
-*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
-*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
-*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
-*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
-*  POSSIBILITY OF SUCH DAMAGE.
-*********************************************************************/
-/** @mainpage CYdLidar(YDLIDAR SDK API)
-    <table>
-        <tr><th>Library     <td>CYdLidar
-        <tr><th>File        <td>CYdLidar.h
-        <tr><th>Author      <td>Tony [code at ydlidar com]
-        <tr><th>Source      <td>https://github.com/ydlidar/YDLidar-SDK
-        <tr><th>Version     <td>1.0.0
-        <tr><th>Sample      <td>[ydlidar test](\ref samples/main.cpp)[G1 G2 G4 G6 S2 X2 X4)\n
-    </table>
-    This API calls Two LiDAR interface classes in the following sections:
-        - @subpage YDlidarDriver
-
-* @copyright    Copyright (c) 2018-2020  EAIBOT
-
-    Jump to the @link ::CYdLidar @endlink interface documentation.
-
-*/
-
-#pragma once
-#include "utils.h"
-#include "ydlidar_driver.h"
-#include <math.h>
-
-using namespace ydlidar;
-
-/**
- * @ref "Dataset"
- * @par Dataset:
-<table>
-<tr><th>LIDAR      <th> Model  <th>  Baudrate <th>  SampleRate(K) <th> Range(m)  		<th>  Frequency(HZ) <th> Intenstiy(bit) <th> SingleChannel<th> voltage(V)
-<tr><th> F4        <td> 1	   <td>  115200   <td>   4            <td>  0.12~12         <td> 5~12           <td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> S4        <td> 4	   <td>  115200   <td>   4            <td>  0.10~8.0        <td> 5~12 (PWM)     <td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> S4B       <td> 4/11   <td>  153600   <td>   4            <td>  0.10~8.0        <td> 5~12(PWM)      <td> true(8)        <td> false    	  <td> 4.8~5.2
-<tr><th> S2        <td> 4/12   <td>  115200   <td>   3            <td>  0.10~8.0     	<td> 4~8(PWM)       <td> false          <td> true    	  <td> 4.8~5.2
-<tr><th> G4        <td> 5	   <td>  230400   <td>   9/8/4        <td>  0.28/0.26/0.1~16<td> 5~12        	<td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> X4        <td> 6	   <td>  128000   <td>   5            <td>  0.12~10     	<td> 5~12(PWM)      <td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> X2/X2L    <td> 6	   <td>  115200   <td>   3            <td>  0.10~8.0     	<td> 4~8(PWM)       <td> false          <td> true    	  <td> 4.8~5.2
-<tr><th> G4PRO     <td> 7	   <td>  230400   <td>   9/8/4        <td>  0.28/0.26/0.1~16<td> 5~12        	<td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> F4PRO     <td> 8	   <td>  230400   <td>   4/6          <td>  0.12~12         <td> 5~12        	<td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> R2        <td> 9	   <td>  230400   <td>   5            <td>  0.12~16         <td> 5~12        	<td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> G6        <td> 13     <td>  512000   <td>   18/16/8      <td>  0.28/0.26/0.1~25<td> 5~12        	<td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> G2A       <td> 14	   <td>  230400   <td>   5            <td>  0.12~12         <td> 5~12      	    <td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> G2        <td> 15     <td>  230400   <td>   5            <td>  0.28~16     	<td> 5~12      	    <td> true(8)        <td> false    	  <td> 4.8~5.2
-<tr><th> G2C       <td> 16	   <td>  115200   <td>   4            <td>  0.1~12        	<td> 5~12      	    <td> false      	<td> false    	  <td> 4.8~5.2
-<tr><th> G4B       <td> 17	   <td>  512000   <td>   10           <td>  0.12~16         <td> 5~12        	<td> true(10)       <td> false    	  <td> 4.8~5.2
-<tr><th> G4C       <td> 18	   <td>  115200   <td>   4            <td>  0.1~12		    <td> 5~12           <td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> G1        <td> 19	   <td>  230400   <td>   9            <td>  0.28~16         <td> 5~12      	    <td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> TX8    　 <td> 100	   <td>  115200   <td>   4            <td>  0.01~8      	<td> 4~8(PWM)       <td> false          <td> true      	  <td> 4.8~5.2
-<tr><th> TX20    　<td> 100	   <td>  115200   <td>   4            <td>  0.01~8      	<td> 4~8(PWM)       <td> false          <td> true     	  <td> 4.8~5.2
-<tr><th> TG15    　<td> 100	   <td>  512000   <td>   20/18/10     <td>  0.01~30      	<td> 3~16      	    <td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> TG30    　<td> 101	   <td>  512000   <td>   20/18/10     <td>  0.01~30      	<td> 3~16      	    <td> false          <td> false    	  <td> 4.8~5.2
-<tr><th> TG50    　<td> 102	   <td>  512000   <td>   20/18/10     <td>  0.01~50      	<td> 3~16      	    <td> false          <td> false    	  <td> 4.8~5.2
-</table>
- */
-
-/**
- * @par example: G4 LiDAR
- * @code
- *    ///< Defining an CYdLidar instance.
- *    CYdLidar laser;
- *    ///< LiDAR Maximum angle
- *    laser.setMaxAngle(180);
- *    ///< LiDAR Minimum angle
- *    laser.setMinAngle(-180);
- *    /// LiDAR Minimum range
- *    laser.setMinRange(0.1);
- *    /// LiDAR Maximum range
- *    laser.setMaxRange(16.0);
- *    ///< LiDAR serial port
- *    laser.setSerialPort("/dev/ydlidar");
- *    ///< G4 LiDAR baudrate
- *    laser.setSerialBaudrate(230400);
- *    ///< Fixed angle resolution
- *    laser.setFixedResolution(false);
- *    ///< rotate 180 degress
- *    laser.setReversion(true);
- *    ///< LiDAR Direction Counterclockwise
- *    laser.setInverted(true);
- *    ///< LiDAR Scan frequency
- *    laser.setScanFrequency(10.0);
- *    ///< LiDAR sample rate
- *    laser.setSampleRate(9);
- *    ///< LiDAR hot plug
- *    laser.setAutoReconnect(true);
- *    ///< LiDAR ignore array
- *    std::vector<float> ignore_array;
- *    laser.setIgnoreArray(ignore_array);
- *    ///LiDAR communication type
- *    laser.setSingleChannel(false);
- *    ///LiDAR Type
- *    laser.setLidarType(TYPE_TRIANGLE);
- *    /// LiDAR connection type
- *    laser.setDeviceType(YDLIDAR_TYPE_SERIAL);
- *    /// LiDAR intensity
- *    laser.setIntensity(false);
- *    /// LiDAR abnormal check count
- *    laser.setAbnormalCheckCount(4);
- *    /// LiDAR Motor DTR
- *    laser.setSupportMotorDtrCtrl(false);
- * @endcode
- */
-
-/**
- * @par example: S2 LiDAR
- * @code
- *    ///< Defining an CYdLidar instance.
- *    CYdLidar laser;
- *    ///< LiDAR Maximum angle
- *    laser.setMaxAngle(180);
- *    ///< LiDAR Minimum angle
- *    laser.setMinAngle(-180);
- *    /// LiDAR Minimum range
- *    laser.setMinRange(0.1);
- *    /// LiDAR Maximum range
- *    laser.setMaxRange(8.0);
- *    ///< LiDAR serial port
- *    laser.setSerialPort("/dev/ydlidar");
- *    ///< G4 LiDAR baudrate
- *    laser.setSerialBaudrate(115200);
- *    ///< Fixed angle resolution
- *    laser.setFixedResolution(false);
- *    ///< rotate 180 degress
- *    laser.setReversion(false);
- *    ///< LiDAR Direction Counterclockwise
- *    laser.setInverted(true);
- *    ///< LiDAR Scan frequency, external PWM
- *    laser.setScanFrequency(6.0);
- *    ///< LiDAR sample rate
- *    laser.setSampleRate(3);
- *    ///< LiDAR hot plug
- *    laser.setAutoReconnect(true);
- *    ///< LiDAR ignore array
- *    std::vector<float> ignore_array;
- *    laser.setIgnoreArray(ignore_array);
- *    ///LiDAR communication type
- *    laser.setSingleChannel(true);
- *    ///LiDAR Type
- *    laser.setLidarType(TYPE_TRIANGLE);
- *    /// LiDAR connection type
- *    laser.setDeviceType(YDLIDAR_TYPE_SERIAL);
- *    /// LiDAR intensity
- *    laser.setIntensity(false);
- *    /// LiDAR abnormal check count
- *    laser.setAbnormalCheckCount(4);
- *    /// LiDAR Motor DTR
- *    laser.setSupportMotorDtrCtrl(true);
- * @endcode
- */
-
-
-/**
- * @par example: TG30 LiDAR
- * @code
- *    ///< Defining an CYdLidar instance.
- *    CYdLidar laser;
- *    ///< LiDAR Maximum angle
- *    laser.setMaxAngle(180);
- *    ///< LiDAR Minimum angle
- *    laser.setMinAngle(-180);
- *    /// LiDAR Minimum range
- *    laser.setMinRange(0.01);
- *    /// LiDAR Maximum range
- *    laser.setMaxRange(32.0);
- *    ///< LiDAR serial port
- *    laser.setSerialPort("/dev/ydlidar");
- *    ///< G4 LiDAR baudrate
- *    laser.setSerialBaudrate(512000);
- *    ///< Fixed angle resolution
- *    laser.setFixedResolution(false);
- *    ///< rotate 180 degress
- *    laser.setReversion(true);
- *    ///< LiDAR Direction Counterclockwise
- *    laser.setInverted(true);
- *    ///< LiDAR Scan frequency
- *    laser.setScanFrequency(10.0);
- *    ///< LiDAR sample rate
- *    laser.setSampleRate(20);
- *    ///< LiDAR hot plug
- *    laser.setAutoReconnect(true);
- *    ///< LiDAR ignore array
- *    std::vector<float> ignore_array;
- *    laser.setIgnoreArray(ignore_array);
- *    ///LiDAR communication type
- *    laser.setSingleChannel(false);
- *    ///LiDAR Type
- *    laser.setLidarType(TYPE_TOF);
- *    /// LiDAR connection type
- *    laser.setDeviceType(YDLIDAR_TYPE_SERIAL);
- *    /// LiDAR intensity
- *    laser.setIntensity(false);
- *    /// LiDAR abnormal check count
- *    laser.setAbnormalCheckCount(4);
- *    /// LiDAR Motor DTR
- *    laser.setSupportMotorDtrCtrl(false);
- * @endcode
- */
-
-/**
- * @par example: TX8 LiDAR
- * @code
- *    ///< Defining an CYdLidar instance.
- *    CYdLidar laser;
- *    ///< LiDAR Maximum angle
- *    laser.setMaxAngle(180);
- *    ///< LiDAR Minimum angle
- *    laser.setMinAngle(-180);
- *    /// LiDAR Minimum range
- *    laser.setMinRange(0.1);
- *    /// LiDAR Maximum range
- *    laser.setMaxRange(8.0);
- *    ///< LiDAR serial port
- *    laser.setSerialPort("/dev/ydlidar");
- *    ///< G4 LiDAR baudrate
- *    laser.setSerialBaudrate(115200);
- *    ///< Fixed angle resolution
- *    laser.setFixedResolution(false);
- *    ///< rotate 180 degress
- *    laser.setReversion(false);
- *    ///< LiDAR Direction Counterclockwise
- *    laser.setInverted(true);
- *    ///< LiDAR Scan frequency, external PWM
- *    laser.setScanFrequency(6.0);
- *    ///< LiDAR sample rate
- *    laser.setSampleRate(4);
- *    ///< LiDAR hot plug
- *    laser.setAutoReconnect(true);
- *    ///< LiDAR ignore array
- *    std::vector<float> ignore_array;
- *    laser.setIgnoreArray(ignore_array);
- *    ///LiDAR communication type
- *    laser.setSingleChannel(true);
- *    ///LiDAR Type
- *    laser.setLidarType(TYPE_TOF);
- *    /// LiDAR connection type
- *    laser.setDeviceType(YDLIDAR_TYPE_SERIAL);
- *    /// LiDAR intensity
- *    laser.setIntensity(false);
- *    /// LiDAR abnormal check count
- *    laser.setAbnormalCheckCount(4);
- *    /// LiDAR Motor DTR
- *    laser.setSupportMotorDtrCtrl(true);
- * @endcode
- */
-
-
-/**
- * @par example: T15 LiDAR
- * @code
- *    ///< Defining an CYdLidar instance.
- *    CYdLidar laser;
- *    ///< LiDAR Maximum angle
- *    laser.setMaxAngle(180);
- *    ///< LiDAR Minimum angle
- *    laser.setMinAngle(-180);
- *    /// LiDAR Minimum range
- *    laser.setMinRange(0.01);
- *    /// LiDAR Maximum range
- *    laser.setMaxRange(64.0);
- *    ///< LiDAR serial port
- *    laser.setSerialPort("192.168.1.11");
- *    ///< G4 LiDAR baudrate
- *    laser.setSerialBaudrate(8000);
- *    ///< Fixed angle resolution
- *    laser.setFixedResolution(false);
- *    ///< rotate 180 degress
- *    laser.setReversion(true);
- *    ///< LiDAR Direction Counterclockwise
- *    laser.setInverted(true);
- *    ///< LiDAR Scan frequency
- *    laser.setScanFrequency(20.0);
- *    ///< LiDAR sample rate
- *    laser.setSampleRate(20);
- *    ///< LiDAR hot plug
- *    laser.setAutoReconnect(true);
- *    ///< LiDAR ignore array
- *    std::vector<float> ignore_array;
- *    laser.setIgnoreArray(ignore_array);
- *    ///LiDAR communication type
- *    laser.setSingleChannel(false);
- *    ///LiDAR Type
- *    laser.setLidarType(TYPE_TOF_NET);
- *    /// LiDAR connection type
- *    laser.setDeviceType(YDLIDAR_TYPE_TCP);
- *    /// LiDAR intensity
- *    laser.setIntensity(true);
- *    /// LiDAR abnormal check count
- *    laser.setAbnormalCheckCount(4);
- *    /// LiDAR Motor DTR
- *    laser.setSupportMotorDtrCtrl(false);
- * @endcode
- */
-
-
-
-/// Provides a platform independent class to for LiDAR development.
-/// This class is designed to serial or socket communication development in a
-/// platform independent manner.
-/// - LiDAR types
-///  -# ydlidar::YDlidarDriver Class
-///  -# ydlidar::ETLidarDriver Class
-///
-
-class YDLIDAR_API CYdLidar {
-  /**
-   * @brief Set and Get LiDAR Maximum effective range.
-   * @note The effective range beyond the maxmum is set to zero.\n
-   * the MaxRange should be greater than the MinRange.
-   * @remarks unit: m
-   * @see ::PropertyBuilderByName and [DataSet](\ref Dataset)
-   * @see CYdLidar::setMaxRange and CYdLidar::getMaxRange
-   */
-  PropertyBuilderByName(float, MaxRange, private);
-  /**
-   * @brief Set and Get LiDAR Minimum effective range.
-   * @note The effective range less than the minmum is set to zero.\n
-   * the MinRange should be less than the MaxRange.
-   * @remarks unit: m
-   * @see ::PropertyBuilderByName and Dataset
-   * @see CYdLidar::setMinRange and CYdLidar::getMinRange
-   */
-  PropertyBuilderByName(float, MinRange,private);
-  /**
-   * @brief Set and Get LiDAR Maximum effective angle.
-   * @note The effective angle beyond the maxmum will be ignored.\n
-   * the MaxAngle should be greater than the MinAngle
-   * @remarks unit: degree, Range:-180~180
-   * @see ::PropertyBuilderByName and Dataset
-   * @see CYdLidar::setMaxAngle and CYdLidar::getMaxAngle
-   */
-  PropertyBuilderByName(float, MaxAngle, private);
-  /**
-   * @brief Set and Get LiDAR Minimum effective angle.
-   * @note The effective angle less than the minmum will be ignored.\n
-   * the MinAngle should be less than the MaxAngle
-   * @remarks unit: degree, Range:-180~180
-   * @see ::PropertyBuilderByName and Dataset
-   * @see CYdLidar::setMinAngle and CYdLidar::getMinAngle
-   */
-  PropertyBuilderByName(float, MinAngle, private);
-  /**
-   * @brief Set and Get LiDAR Sampling rate.
-   * @note If the set sampling rate does no exist.
-   * the actual sampling rate is the LiDAR's default sampling rate.\n
-   * Set the sampling rate to match the LiDAR.
-   * @remarks unit: kHz/s, Ranges: 2,3,4,5,6,8,9,10,16,18,20\n
-   <table>
-        <tr><th>G4/F4               <td>4,8,9
-        <tr><th>F4PRO               <td>4,6
-        <tr><th>G6                  <td>8,16,18
-        <tr><th>G4B                 <td>10
-        <tr><th>G1                  <td>9
-        <tr><th>G2A/G2/R2/X4        <td>5
-        <tr><th>S4/S4B/G4C/TX8/TX20 <td>4
-        <tr><th>G2C                 <td>4
-        <tr><th>S2                  <td>3
-        <tr><th>TG15/TG30/TG50      <td>10,18,20
-        <tr><th>T5/T15              <td>20
-    </table>
-   * @see CYdLidar::setSampleRate and CYdLidar::getSampleRate
-   */
-  PropertyBuilderByName(int, SampleRate, private);
-  /**
-   * @brief Set and Get LiDAR Scan frequency.
-   * @note If the LiDAR is a single channel,
-   * the scanning frequency nneds to be adjusted by external PWM.\n
-   * Set the scan frequency to match the LiDAR.
-   * @remarks unit: Hz\n
-   <table>
-        <tr><th>S2/X2/X2L/TX8/TX20              <td>4~8(PWM)
-        <tr><th>F4/F4PRO/G4/G4PRO/R2            <td>5~12
-        <tr><th>G6/G2A/G2/G2C/G4B/G4C/G1        <td>5~12
-        <tr><th>S4/S4B/X4                       <td>5~12(PWM)
-        <tr><th>TG15/TG30/TG50                  <td>3~16
-        <tr><th>T5/T15                          <td>5~40
-    </table>
-   * @see CYdLidar::setScanFrequency and CYdLidar::getScanFrequency
-   */
-  PropertyBuilderByName(float, ScanFrequency, private);
-  /**
-   * @brief Set and Get LiDAR Fixed angluar resolution.\n
-   * @note The Lidar scanning frequency will change slightly due to various reasons.
-   * so the number of points per circle will also change slightly.\n
-   * if a fixed angluar resolution is required.
-   * a fixed number of points is required.
-   * @details If set to true,
-   * the angle_increment of the fixed angle resolution in LaserConfig will be a fixed value.
-   * @see CYdLidar::setFixedResolution and CYdLidar::getFixedResolution
-   */
-  PropertyBuilderByName(bool, FixedResolution, private);
-  /**
-   * @brief Set and Get LiDAR Reversion.\n
-   * true: LiDAR data rotated 180 degrees.\n
-   * false: Keep raw Data.\n
-   * default: false\n
-   * @note Refer to the table below for the LiDAR Reversion.\n
-   * This is currently related to your coordinate system and install direction.
-   * Whether to reverse it depends on your actual scene.
-   * @par Reversion Table
-   <table>
-        <tr><th>LiDAR                           <th>reversion
-        <tr><th>G1/G2/G2A/G2C/F4/F4PRO/R2       <td>true
-        <tr><th>G4/G4PRO/G4B/G4C/G6             <td>true
-        <tr><th>TG15/TG30/TG50                  <td>true
-        <tr><th>T5/T15                          <td>true
-        <tr><th>S2/X2/X2L/X4/S4/S4B             <td>false
-        <tr><th>TX8/TX20                        <td>false
-    </table>
-   * @see CYdLidar::setReversion and CYdLidar::getReversion
-   */
-  PropertyBuilderByName(bool, Reversion, private);
-  /**
-   * @brief Set and Get LiDAR inverted.\n
-   * true: Data is counterclockwise\n
-   * false: Data is clockwise\n
-   * Default: clockwise
-   * @note If set to true, LiDAR data direction is positive counterclockwise.
-   * otherwise it is positive clockwise.
-   * @see CYdLidar::setInverted and CYdLidar::getInverted
-   */
-  PropertyBuilderByName(bool, Inverted, private);
-  /**
-   * @brief Set and Get LiDAR Automatically reconnect flag.\n
-   * Whether to support hot plug.
-   * @see CYdLidar::setAutoReconnect and CYdLidar::getAutoReconnect
-   */
-  PropertyBuilderByName(bool, AutoReconnect, private);
-  /**
-  * @brief Set and Get LiDAR baudrate or network port.
-  * @note Refer to the table below for the LiDAR Baud Rate.\n
-  * Set the baudrate or network port to match the LiDAR.
-  * @remarks
-  <table>
-       <tr><th>F4/S2/X2/X2L/S4/TX8/TX20/G4C        <td>115200
-       <tr><th>X4                                  <td>128000
-       <tr><th>S4B                                 <td>153600
-       <tr><th>G1/G2/R2/G4/G4PRO/F4PRO             <td>230400
-       <tr><th>G2A/G2C                             <td>230400
-       <tr><th>G6/G4B/TG15/TG30/TG50               <td>512000
-       <tr><th>T5/T15(network)                     <td>8000
-   </table>
-  * @see CYdLidar::setSerialBaudrate and CYdLidar::getSerialBaudrate
-  */
-  PropertyBuilderByName(int, SerialBaudrate, private);
-  /**
-   * @brief Set and Get LiDAR Maximum number of abnormal checks.
-   * @note When the LiDAR Turn On, if the number of times of abnormal data acquisition
-   * is greater than the current AbnormalCheckCount, the LiDAR Fails to Turn On.\n
-   * @details The Minimum abnormal value is Two,
-   * if it is less than the Minimum Value, it will be set to the Mimimum Value.\n
-   * @see CYdLidar::setAbnormalCheckCount and CYdLidar::getAbnormalCheckCount
-   */
-  PropertyBuilderByName(int, AbnormalCheckCount, private);
-  /**
-   * @brief Set and Get LiDAR Serial port or network IP address.
-   * @note If it is serial port,
-   * your need to ensure that the serial port had read and write permissions.\n
-   * If it is a network, make sure the network can ping.\n
-   * @see CYdLidar::setSerialPort and CYdLidar::getSerialPort
-   */
-  PropertyBuilderByName(std::string, SerialPort, private);
-  /**
-   * @brief Set and Get LiDAR  filtering angle area.
-   * @note If the LiDAR angle is in the IgnoreArray,
-   * the current range will be set to zero.\n
-   * Filtering angles need to appear in pairs.\n
-   * @details The purpose of the current paramter is to filter out the angular area set by user\n
-   * @par example: Filters 10 degrees to 30 degrees and 80 degrees to 90 degrees.
-   * @code
-   *    CYdLidar laser;//Defining an CYdLidar instance.
-   *    std::vector<float> ignore_array;
-   *    ignore_array.push_back(10.0);
-   *    ignore_array.push_back(30.0);
-   *    ignore_array.push_back(80.0);
-   *    ignore_array.push_back(90.0);
-   *    laser.setIgnoreArray(ignore_array);
-   * @endcode
-   * @see CYdLidar::setIgnoreArray and CYdLidar::getIgnoreArray
-   */
-  PropertyBuilderByName(std::vector<float>, IgnoreArray, private);
-
-  PropertyBuilderByName(float, OffsetTime, private);
-  /**
-   * @brief Set and Get LiDAR single channel.
-   * Whether LiDAR communication channel is a single-channel
-   * @note For a single-channel LiDAR, if the settings are reversed.\n
-   * an error will occur in obtaining device information and the LiDAR will Faied to Start.\n
-   * For dual-channel LiDAR, if th setttings are reversed.\n
-   * the device information cannot be obtained.\n
-   * Set the single channel to match the LiDAR.
-   * @remarks
-   <table>
-        <tr><th>G1/G2/G2A/G2C                          <td>false
-        <tr><th>G4/G4B/G4PRO/G6/F4/F4PRO               <td>false
-        <tr><th>S4/S4B/X4/R2/G4C                       <td>false
-        <tr><th>S2/X2/X2L                              <td>true
-        <tr><th>TG15/TG30/TG50                         <td>false
-        <tr><th>TX8/TX20                               <td>true
-        <tr><th>T5/T15                                 <td>false
-        <tr><th>                                       <td>true
-    </table>
-   * @see CYdLidar::setSingleChannel and CYdLidar::getSingleChannel
-   */
-  PropertyBuilderByName(bool, SingleChannel, private);
-  /**
-  * @brief Set and Get LiDAR Type.
-  * @note Refer to the table below for the LiDAR Type.\n
-  * Set the LiDAR Type to match the LiDAR.
-  * @remarks
-  <table>
-       <tr><th>G1/G2A/G2/G2C                    <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
-       <tr><th>G4/G4B/G4C/G4PRO                 <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
-       <tr><th>G6/F4/F4PRO                      <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
-       <tr><th>S4/S4B/X4/R2/S2/X2/X2L           <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
-       <tr><th>TG15/TG30/TG50/TX8/TX20          <td>[TYPE_TOF](\ref LidarTypeID::TYPE_TOF)
-       <tr><th>T5/T15                           <td>[TYPE_TOF_NET](\ref LidarTypeID::TYPE_TOF_NET)
-   </table>
-  * @see [LidarTypeID](\ref LidarTypeID)
-  * @see CYdLidar::setLidarType and CYdLidar::getLidarType
-  */
-  PropertyBuilderByName(int, LidarType, private);
-
-  PropertyBuilderByName(bool, Intensity,
-                          private) ///< 是否有信号质量
-
- public:
-  CYdLidar(); //!< Constructor
-  virtual ~CYdLidar();  //!< Destructor: turns the laser off.
-  /*!
-   * @brief initialize
-   * @return
-   */
-  bool initialize();  //!< Attempts to connect and turns the laser on. Raises an exception on error.
-
-  // Return true if laser data acquistion succeeds, If it's not
-  bool doProcessSimple(LaserScan &outscan,
-                       bool &hardwareError);
-
-  //Turn on the motor enable
-  bool  turnOn();  //!< See base class docs
-
-  //Turn off the motor enable and close the scan
-  bool  turnOff(); //!< See base class docs
-
-  //Turn off lidar connection
-  void disconnecting(); //!< Closes the comms with the laser. Shouldn't have to be directly needed by the user
-
-  //get zero angle offset value
-  float getAngleOffset() const;
-
-  //Whether the zero offset angle is corrected?
-  bool isAngleOffetCorrected() const;
-
-  //! get lidar software version
-  std::string getSoftVersion() const;
-
-  //! get lidar hardware version
-  std::string getHardwareVersion() const;
-
-  //! get lidar serial number
-  std::string getSerialNumber() const;
-
-  bool reset(uint8_t addr=0x01);
-
- protected:
-  /*! Returns true if communication has been established with the device. If it's not,
-    *  try to create a comms channel.
-    * \return false on error.
-    */
-  bool  checkCOMMs();
-
-  /*! Returns true if health status and device information has been obtained with the device. If it's not,
-    * \return false on error.
-    */
-  bool  checkStatus();
-
-  /*! Returns true if the normal scan runs with the device. If it's not,
-    * \return false on error.
-    */
-  bool checkHardware();
-
-  /*! returns true if the lidar data is normal, If it's not*/
-  bool checkLidarAbnormal();
-
-  /*!
-   * @brief checkCalibrationAngle
-   * @param serialNumber
-   */
-  void checkCalibrationAngle(const std::string &serialNumber);
-
-  /*!
-    * @brief isRangeValid
-    * @param reading
-    * @return
-    */
-  bool isRangeValid(double reading) const;
-
-  /*!
-   * @brief isRangeIgnore
-   * @param angle
-   * @return
-   */
-  bool isRangeIgnore(double angle) const;
-
-  /*!
-   * @brief handleSingleChannelDevice
-   */
-  void handleSingleChannelDevice();
-
-  /**
-   * @brief parsePackageNode
-   * @param node
-   * @param info
-   */
-  void parsePackageNode(const node_info &node, LaserDebug &info);
-
-  /**
-   * @brief handleDeviceInfoPackage
-   * @param count
-   */
-  void handleDeviceInfoPackage(int count);
-
-  /**
-   * @brief printfVersionInfo
-   * @param info
-   */
-  void printfVersionInfo(const device_info &info);
-
- private:
-  bool    isScanning;
-  int     m_FixedSize ;
-  float   m_AngleOffset;
-  bool    m_isAngleOffsetCorrected;
-  float   frequencyOffset;
-  int   lidar_model;
-  uint8_t Major;
-  uint8_t Minjor;
-  YDlidarDriver *lidarPtr;
-  uint64_t m_PointTime;
-  uint64_t last_node_time;
-  node_info *global_nodes;
-  std::map<int, int> SampleRateMap;
-  bool m_ParseSuccess;
-  std::string m_lidarSoftVer;
-  std::string m_lidarHardVer;
-  std::string m_lidarSerialNum;
-  int defalutSampleRate;
-  int m_UserSampleRate;
-};	// End of class
-
+﻿/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+/** @mainpage CYdLidar(YDLIDAR SDK API)
+    <table>
+        <tr><th>Library     <td>CYdLidar
+        <tr><th>File        <td>CYdLidar.h
+        <tr><th>Author      <td>Tony [code at ydlidar com]
+        <tr><th>Source      <td>https://github.com/ydlidar/YDLidar-SDK
+        <tr><th>Version     <td>1.0.0
+        <tr><th>Sample      <td>[ydlidar test](\ref samples/main.cpp)[G1 G2 G4 G6 S2 X2 X4)\n
+    </table>
+    This API calls Two LiDAR interface classes in the following sections:
+        - @subpage YDlidarDriver
+
+* @copyright    Copyright (c) 2018-2020  EAIBOT
+
+    Jump to the @link ::CYdLidar @endlink interface documentation.
+
+*/
+
+#pragma once
+#include "utils.h"
+#include "ydlidar_driver.h"
+#include "lidar_deskew.h"
+#include <math.h>
+
+using namespace ydlidar;
+
+/**
+ * @ref "Dataset"
+ * @par Dataset:
+<table>
+<tr><th>LIDAR      <th> Model  <th>  Baudrate <th>  SampleRate(K) <th> Range(m)  		<th>  Frequency(HZ) <th> Intenstiy(bit) <th> SingleChannel<th> voltage(V)
+<tr><th> F4        <td> 1	   <td>  115200   <td>   4            <td>  0.12~12         <td> 5~12           <td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> S4        <td> 4	   <td>  115200   <td>   4            <td>  0.10~8.0        <td> 5~12 (PWM)     <td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> S4B       <td> 4/11   <td>  153600   <td>   4            <td>  0.10~8.0        <td> 5~12(PWM)      <td> true(8)        <td> false    	  <td> 4.8~5.2
+<tr><th> S2        <td> 4/12   <td>  115200   <td>   3            <td>  0.10~8.0     	<td> 4~8(PWM)       <td> false          <td> true    	  <td> 4.8~5.2
+<tr><th> G4        <td> 5	   <td>  230400   <td>   9/8/4        <td>  0.28/0.26/0.1~16<td> 5~12        	<td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> X4        <td> 6	   <td>  128000   <td>   5            <td>  0.12~10     	<td> 5~12(PWM)      <td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> X2/X2L    <td> 6	   <td>  115200   <td>   3            <td>  0.10~8.0     	<td> 4~8(PWM)       <td> false          <td> true    	  <td> 4.8~5.2
+<tr><th> G4PRO     <td> 7	   <td>  230400   <td>   9/8/4        <td>  0.28/0.26/0.1~16<td> 5~12        	<td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> F4PRO     <td> 8	   <td>  230400   <td>   4/6          <td>  0.12~12         <td> 5~12        	<td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> R2        <td> 9	   <td>  230400   <td>   5            <td>  0.12~16         <td> 5~12        	<td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> G6        <td> 13     <td>  512000   <td>   18/16/8      <td>  0.28/0.26/0.1~25<td> 5~12        	<td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> G2A       <td> 14	   <td>  230400   <td>   5            <td>  0.12~12         <td> 5~12      	    <td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> G2        <td> 15     <td>  230400   <td>   5            <td>  0.28~16     	<td> 5~12      	    <td> true(8)        <td> false    	  <td> 4.8~5.2
+<tr><th> G2C       <td> 16	   <td>  115200   <td>   4            <td>  0.1~12        	<td> 5~12      	    <td> false      	<td> false    	  <td> 4.8~5.2
+<tr><th> G4B       <td> 17	   <td>  512000   <td>   10           <td>  0.12~16         <td> 5~12        	<td> true(10)       <td> false    	  <td> 4.8~5.2
+<tr><th> G4C       <td> 18	   <td>  115200   <td>   4            <td>  0.1~12		    <td> 5~12           <td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> G1        <td> 19	   <td>  230400   <td>   9            <td>  0.28~16         <td> 5~12      	    <td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> TX8    　 <td> 100	   <td>  115200   <td>   4            <td>  0.01~8      	<td> 4~8(PWM)       <td> false          <td> true      	  <td> 4.8~5.2
+<tr><th> TX20    　<td> 100	   <td>  115200   <td>   4            <td>  0.01~8      	<td> 4~8(PWM)       <td> false          <td> true     	  <td> 4.8~5.2
+<tr><th> TG15    　<td> 100	   <td>  512000   <td>   20/18/10     <td>  0.01~30      	<td> 3~16      	    <td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> TG30    　<td> 101	   <td>  512000   <td>   20/18/10     <td>  0.01~30      	<td> 3~16      	    <td> false          <td> false    	  <td> 4.8~5.2
+<tr><th> TG50    　<td> 102	   <td>  512000   <td>   20/18/10     <td>  0.01~50      	<td> 3~16      	    <td> false          <td> false    	  <td> 4.8~5.2
+</table>
+ */
+
+/**
+ * @par example: G4 LiDAR
+ * @code
+ *    ///< Defining an CYdLidar instance.
+ *    CYdLidar laser;
+ *    ///< LiDAR Maximum angle
+ *    laser.setMaxAngle(180);
+ *    ///< LiDAR Minimum angle
+ *    laser.setMinAngle(-180);
+ *    /// LiDAR Minimum range
+ *    laser.setMinRange(0.1);
+ *    /// LiDAR Maximum range
+ *    laser.setMaxRange(16.0);
+ *    ///< LiDAR serial port
+ *    laser.setSerialPort("/dev/ydlidar");
+ *    ///< G4 LiDAR baudrate
+ *    laser.setSerialBaudrate(230400);
+ *    ///< Fixed angle resolution
+ *    laser.setFixedResolution(false);
+ *    ///< rotate 180 degress
+ *    laser.setReversion(true);
+ *    ///< LiDAR Direction Counterclockwise
+ *    laser.setInverted(true);
+ *    ///< LiDAR Scan frequency
+ *    laser.setScanFrequency(10.0);
+ *    ///< LiDAR sample rate
+ *    laser.setSampleRate(9);
+ *    ///< LiDAR hot plug
+ *    laser.setAutoReconnect(true);
+ *    ///< LiDAR ignore array
+ *    std::vector<float> ignore_array;
+ *    laser.setIgnoreArray(ignore_array);
+ *    ///LiDAR communication type
+ *    laser.setSingleChannel(false);
+ *    ///LiDAR Type
+ *    laser.setLidarType(TYPE_TRIANGLE);
+ *    /// LiDAR connection type
+ *    laser.setDeviceType(YDLIDAR_TYPE_SERIAL);
+ *    /// LiDAR intensity
+ *    laser.setIntensity(false);
+ *    /// LiDAR abnormal check count
+ *    laser.setAbnormalCheckCount(4);
+ *    /// LiDAR Motor DTR
+ *    laser.setSupportMotorDtrCtrl(false);
+ * @endcode
+ */
+
+/**
+ * @par example: S2 LiDAR
+ * @code
+ *    ///< Defining an CYdLidar instance.
+ *    CYdLidar laser;
+ *    ///< LiDAR Maximum angle
+ *    laser.setMaxAngle(180);
+ *    ///< LiDAR Minimum angle
+ *    laser.setMinAngle(-180);
+ *    /// LiDAR Minimum range
+ *    laser.setMinRange(0.1);
+ *    /// LiDAR Maximum range
+ *    laser.setMaxRange(8.0);
+ *    ///< LiDAR serial port
+ *    laser.setSerialPort("/dev/ydlidar");
+ *    ///< G4 LiDAR baudrate
+ *    laser.setSerialBaudrate(115200);
+ *    ///< Fixed angle resolution
+ *    laser.setFixedResolution(false);
+ *    ///< rotate 180 degress
+ *    laser.setReversion(false);
+ *    ///< LiDAR Direction Counterclockwise
+ *    laser.setInverted(true);
+ *    ///< LiDAR Scan frequency, external PWM
+ *    laser.setScanFrequency(6.0);
+ *    ///< LiDAR sample rate
+ *    laser.setSampleRate(3);
+ *    ///< LiDAR hot plug
+ *    laser.setAutoReconnect(true);
+ *    ///< LiDAR ignore array
+ *    std::vector<float> ignore_array;
+ *    laser.setIgnoreArray(ignore_array);
+ *    ///LiDAR communication type
+ *    laser.setSingleChannel(true);
+ *    ///LiDAR Type
+ *    laser.setLidarType(TYPE_TRIANGLE);
+ *    /// LiDAR connection type
+ *    laser.setDeviceType(YDLIDAR_TYPE_SERIAL);
+ *    /// LiDAR intensity
+ *    laser.setIntensity(false);
+ *    /// LiDAR abnormal check count
+ *    laser.setAbnormalCheckCount(4);
+ *    /// LiDAR Motor DTR
+ *    laser.setSupportMotorDtrCtrl(true);
+ * @endcode
+ */
+
+
+/**
+ * @par example: TG30 LiDAR
+ * @code
+ *    ///< Defining an CYdLidar instance.
+ *    CYdLidar laser;
+ *    ///< LiDAR Maximum angle
+ *    laser.setMaxAngle(180);
+ *    ///< LiDAR Minimum angle
+ *    laser.setMinAngle(-180);
+ *    /// LiDAR Minimum range
+ *    laser.setMinRange(0.01);
+ *    /// LiDAR Maximum range
+ *    laser.setMaxRange(32.0);
+ *    ///< LiDAR serial port
+ *    laser.setSerialPort("/dev/ydlidar");
+ *    ///< G4 LiDAR baudrate
+ *    laser.setSerialBaudrate(512000);
+ *    ///< Fixed angle resolution
+ *    laser.setFixedResolution(false);
+ *    ///< rotate 180 degress
+ *    laser.setReversion(true);
+ *    ///< LiDAR Direction Counterclockwise
+ *    laser.setInverted(true);
+ *    ///< LiDAR Scan frequency
+ *    laser.setScanFrequency(10.0);
+ *    ///< LiDAR sample rate
+ *    laser.setSampleRate(20);
+ *    ///< LiDAR hot plug
+ *    laser.setAutoReconnect(true);
+ *    ///< LiDAR ignore array
+ *    std::vector<float> ignore_array;
+ *    laser.setIgnoreArray(ignore_array);
+ *    ///LiDAR communication type
+ *    laser.setSingleChannel(false);
+ *    ///LiDAR Type
+ *    laser.setLidarType(TYPE_TOF);
+ *    /// LiDAR connection type
+ *    laser.setDeviceType(YDLIDAR_TYPE_SERIAL);
+ *    /// LiDAR intensity
+ *    laser.setIntensity(false);
+ *    /// LiDAR abnormal check count
+ *    laser.setAbnormalCheckCount(4);
+ *    /// LiDAR Motor DTR
+ *    laser.setSupportMotorDtrCtrl(false);
+ * @endcode
+ */
+
+/**
+ * @par example: TX8 LiDAR
+ * @code
+ *    ///< Defining an CYdLidar instance.
+ *    CYdLidar laser;
+ *    ///< LiDAR Maximum angle
+ *    laser.setMaxAngle(180);
+ *    ///< LiDAR Minimum angle
+ *    laser.setMinAngle(-180);
+ *    /// LiDAR Minimum range
+ *    laser.setMinRange(0.1);
+ *    /// LiDAR Maximum range
+ *    laser.setMaxRange(8.0);
+ *    ///< LiDAR serial port
+ *    laser.setSerialPort("/dev/ydlidar");
+ *    ///< G4 LiDAR baudrate
+ *    laser.setSerialBaudrate(115200);
+ *    ///< Fixed angle resolution
+ *    laser.setFixedResolution(false);
+ *    ///< rotate 180 degress
+ *    laser.setReversion(false);
+ *    ///< LiDAR Direction Counterclockwise
+ *    laser.setInverted(true);
+ *    ///< LiDAR Scan frequency, external PWM
+ *    laser.setScanFrequency(6.0);
+ *    ///< LiDAR sample rate
+ *    laser.setSampleRate(4);
+ *    ///< LiDAR hot plug
+ *    laser.setAutoReconnect(true);
+ *    ///< LiDAR ignore array
+ *    std::vector<float> ignore_array;
+ *    laser.setIgnoreArray(ignore_array);
+ *    ///LiDAR communication type
+ *    laser.setSingleChannel(true);
+ *    ///LiDAR Type
+ *    laser.setLidarType(TYPE_TOF);
+ *    /// LiDAR connection type
+ *    laser.setDeviceType(YDLIDAR_TYPE_SERIAL);
+ *    /// LiDAR intensity
+ *    laser.setIntensity(false);
+ *    /// LiDAR abnormal check count
+ *    laser.setAbnormalCheckCount(4);
+ *    /// LiDAR Motor DTR
+ *    laser.setSupportMotorDtrCtrl(true);
+ * @endcode
+ */
+
+
+/**
+ * @par example: T15 LiDAR
+ * @code
+ *    ///< Defining an CYdLidar instance.
+ *    CYdLidar laser;
+ *    ///< LiDAR Maximum angle
+ *    laser.setMaxAngle(180);
+ *    ///< LiDAR Minimum angle
+ *    laser.setMinAngle(-180);
+ *    /// LiDAR Minimum range
+ *    laser.setMinRange(0.01);
+ *    /// LiDAR Maximum range
+ *    laser.setMaxRange(64.0);
+ *    ///< LiDAR serial port
+ *    laser.setSerialPort("192.168.1.11");
+ *    ///< G4 LiDAR baudrate
+ *    laser.setSerialBaudrate(8000);
+ *    ///< Fixed angle resolution
+ *    laser.setFixedResolution(false);
+ *    ///< rotate 180 degress
+ *    laser.setReversion(true);
+ *    ///< LiDAR Direction Counterclockwise
+ *    laser.setInverted(true);
+ *    ///< LiDAR Scan frequency
+ *    laser.setScanFrequency(20.0);
+ *    ///< LiDAR sample rate
+ *    laser.setSampleRate(20);
+ *    ///< LiDAR hot plug
+ *    laser.setAutoReconnect(true);
+ *    ///< LiDAR ignore array
+ *    std::vector<float> ignore_array;
+ *    laser.setIgnoreArray(ignore_array);
+ *    ///LiDAR communication type
+ *    laser.setSingleChannel(false);
+ *    ///LiDAR Type
+ *    laser.setLidarType(TYPE_TOF_NET);
+ *    /// LiDAR connection type
+ *    laser.setDeviceType(YDLIDAR_TYPE_TCP);
+ *    /// LiDAR intensity
+ *    laser.setIntensity(true);
+ *    /// LiDAR abnormal check count
+ *    laser.setAbnormalCheckCount(4);
+ *    /// LiDAR Motor DTR
+ *    laser.setSupportMotorDtrCtrl(false);
+ * @endcode
+ */
+
+
+
+/// 角度查找表分辨率[度]
+#define AngleMaskResolution 0.1
+
+/// 角度查找表项
+enum AngleMaskFlag {
+  ANGLE_MASK_IGNORE = 0x01, ///< 在忽略区间内
+  ANGLE_MASK_OUTSIDE = 0x02,///< 在最小最大角度范围外
+  ANGLE_MASK_EXACT = 0x04,  ///< 靠近区间边界, 需要精确判断
+};
+
+/*!
+* 角度区间, 宽度不大于π \n
+* 直角坐标输出用边界方向向量的叉积判断点是否在区间内, 不计算点的角度
+*/
+struct AngleSector {
+  float lo_x, lo_y; ///< 起始边界方向
+  float hi_x, hi_y; ///< 结束边界方向
+
+  /// 方向(x, y)在区间内, 含边界
+  bool contains(float x, float y) const {
+    return lo_x * y - lo_y * x >= 0 && hi_y * x - hi_x * y >= 0;
+  }
+};
+
+/// 合并帧中带采集时间的激光点
+struct MergedLaserPoint {
+  LaserPoint point; ///< 激光点
+  uint64_t   stamp; ///< 采集时间[ns]
+};
+
+
+/// Provides a platform independent class to for LiDAR development.
+/// This class is designed to serial or socket communication development in a
+/// platform independent manner.
+/// - LiDAR types
+///  -# ydlidar::YDlidarDriver Class
+///  -# ydlidar::ETLidarDriver Class
+///
+
+class YDLIDAR_API CYdLidar {
+  /**
+   * @brief Set and Get LiDAR Maximum effective range.
+   * @note The effective range beyond the maxmum is set to zero.\n
+   * the MaxRange should be greater than the MinRange.
+   * @remarks unit: m
+   * @see ::PropertyBuilderByName and [DataSet](\ref Dataset)
+   * @see CYdLidar::setMaxRange and CYdLidar::getMaxRange
+   */
+  PropertyBuilderByName(float, MaxRange, private);
+  /**
+   * @brief Set and Get LiDAR Minimum effective range.
+   * @note The effective range less than the minmum is set to zero.\n
+   * the MinRange should be less than the MaxRange.
+   * @remarks unit: m
+   * @see ::PropertyBuilderByName and Dataset
+   * @see CYdLidar::setMinRange and CYdLidar::getMinRange
+   */
+  PropertyBuilderByName(float, MinRange,private);
+  /**
+   * @brief Set and Get LiDAR Maximum effective angle.
+   * @note The effective angle beyond the maxmum will be ignored.\n
+   * the MaxAngle should be greater than the MinAngle
+   * @remarks unit: degree, Range:-180~180
+   * @see ::PropertyBuilderByName and Dataset
+   * @see CYdLidar::setMaxAngle and CYdLidar::getMaxAngle
+   */
+  PropertyBuilderByName(float, MaxAngle, private);
+  /**
+   * @brief Set and Get LiDAR Minimum effective angle.
+   * @note The effective angle less than the minmum will be ignored.\n
+   * the MinAngle should be less than the MaxAngle
+   * @remarks unit: degree, Range:-180~180
+   * @see ::PropertyBuilderByName and Dataset
+   * @see CYdLidar::setMinAngle and CYdLidar::getMinAngle
+   */
+  PropertyBuilderByName(float, MinAngle, private);
+  /**
+   * @brief Set and Get LiDAR Sampling rate.
+   * @note If the set sampling rate does no exist.
+   * the actual sampling rate is the LiDAR's default sampling rate.\n
+   * Set the sampling rate to match the LiDAR.
+   * @remarks unit: kHz/s, Ranges: 2,3,4,5,6,8,9,10,16,18,20\n
+   <table>
+        <tr><th>G4/F4               <td>4,8,9
+        <tr><th>F4PRO               <td>4,6
+        <tr><th>G6                  <td>8,16,18
+        <tr><th>G4B                 <td>10
+        <tr><th>G1                  <td>9
+        <tr><th>G2A/G2/R2/X4        <td>5
+        <tr><th>S4/S4B/G4C/TX8/TX20 <td>4
+        <tr><th>G2C                 <td>4
+        <tr><th>S2                  <td>3
+        <tr><th>TG15/TG30/TG50      <td>10,18,20
+        <tr><th>T5/T15              <td>20
+    </table>
+   * @see CYdLidar::setSampleRate and CYdLidar::getSampleRate
+   */
+  PropertyBuilderByName(int, SampleRate, private);
+  /**
+   * @brief Set and Get LiDAR Scan frequency.
+   * @note If the LiDAR is a single channel,
+   * the scanning frequency nneds to be adjusted by external PWM.\n
+   * Set the scan frequency to match the LiDAR.
+   * @remarks unit: Hz\n
+   <table>
+        <tr><th>S2/X2/X2L/TX8/TX20              <td>4~8(PWM)
+        <tr><th>F4/F4PRO/G4/G4PRO/R2            <td>5~12
+        <tr><th>G6/G2A/G2/G2C/G4B/G4C/G1        <td>5~12
+        <tr><th>S4/S4B/X4                       <td>5~12(PWM)
+        <tr><th>TG15/TG30/TG50                  <td>3~16
+        <tr><th>T5/T15                          <td>5~40
+    </table>
+   * @see CYdLidar::setScanFrequency and CYdLidar::getScanFrequency
+   */
+  PropertyBuilderByName(float, ScanFrequency, private);
+  /**
+   * @brief Set and Get LiDAR Fixed angluar resolution.\n
+   * @note The Lidar scanning frequency will change slightly due to various reasons.
+   * so the number of points per circle will also change slightly.\n
+   * if a fixed angluar resolution is required.
+   * a fixed number of points is required.
+   * @details If set to true,
+   * the angle_increment of the fixed angle resolution in LaserConfig will be a fixed value.
+   * @see CYdLidar::setFixedResolution and CYdLidar::getFixedResolution
+   */
+  PropertyBuilderByName(bool, FixedResolution, private);
+  /**
+   * @brief Set and Get LiDAR Reversion.\n
+   * true: LiDAR data rotated 180 degrees.\n
+   * false: Keep raw Data.\n
+   * default: false\n
+   * @note Refer to the table below for the LiDAR Reversion.\n
+   * This is currently related to your coordinate system and install direction.
+   * Whether to reverse it depends on your actual scene.
+   * @par Reversion Table
+   <table>
+        <tr><th>LiDAR                           <th>reversion
+        <tr><th>G1/G2/G2A/G2C/F4/F4PRO/R2       <td>true
+        <tr><th>G4/G4PRO/G4B/G4C/G6             <td>true
+        <tr><th>TG15/TG30/TG50                  <td>true
+        <tr><th>T5/T15                          <td>true
+        <tr><th>S2/X2/X2L/X4/S4/S4B             <td>false
+        <tr><th>TX8/TX20                        <td>false
+    </table>
+   * @see CYdLidar::setReversion and CYdLidar::getReversion
+   */
+  PropertyBuilderByName(bool, Reversion, private);
+  /**
+   * @brief Set and Get LiDAR inverted.\n
+   * true: Data is counterclockwise\n
+   * false: Data is clockwise\n
+   * Default: clockwise
+   * @note If set to true, LiDAR data direction is positive counterclockwise.
+   * otherwise it is positive clockwise.
+   * @see CYdLidar::setInverted and CYdLidar::getInverted
+   */
+  PropertyBuilderByName(bool, Inverted, private);
+  /**
+   * @brief Set and Get LiDAR Automatically reconnect flag.\n
+   * Whether to support hot plug.
+   * @see CYdLidar::setAutoReconnect and CYdLidar::getAutoReconnect
+   */
+  PropertyBuilderByName(bool, AutoReconnect, private);
+  /**
+  * @brief Set and Get LiDAR baudrate or network port.
+  * @note Refer to the table below for the LiDAR Baud Rate.\n
+  * Set the baudrate or network port to match the LiDAR.
+  * @remarks
+  <table>
+       <tr><th>F4/S2/X2/X2L/S4/TX8/TX20/G4C        <td>115200
+       <tr><th>X4                                  <td>128000
+       <tr><th>S4B                                 <td>153600
+       <tr><th>G1/G2/R2/G4/G4PRO/F4PRO             <td>230400
+       <tr><th>G2A/G2C                             <td>230400
+       <tr><th>G6/G4B/TG15/TG30/TG50               <td>512000
+       <tr><th>T5/T15(network)                     <td>8000
+   </table>
+  * @see CYdLidar::setSerialBaudrate and CYdLidar::getSerialBaudrate
+  */
+  PropertyBuilderByName(int, SerialBaudrate, private);
+  /**
+   * @brief Set and Get LiDAR Maximum number of abnormal checks.
+   * @note When the LiDAR Turn On, if the number of times of abnormal data acquisition
+   * is greater than the current AbnormalCheckCount, the LiDAR Fails to Turn On.\n
+   * @details The Minimum abnormal value is Two,
+   * if it is less than the Minimum Value, it will be set to the Mimimum Value.\n
+   * @see CYdLidar::setAbnormalCheckCount and CYdLidar::getAbnormalCheckCount
+   */
+  PropertyBuilderByName(int, AbnormalCheckCount, private);
+  /**
+   * @brief Set and Get LiDAR Serial port or network IP address.
+   * @note If it is serial port,
+   * your need to ensure that the serial port had read and write permissions.\n
+   * If it is a network, make sure the network can ping.\n
+   * @see CYdLidar::setSerialPort and CYdLidar::getSerialPort
+   */
+  PropertyBuilderByName(std::string, SerialPort, private);
+  /**
+   * @brief Set and Get LiDAR  filtering angle area.
+   * @note If the LiDAR angle is in the IgnoreArray,
+   * the current range will be set to zero.\n
+   * Filtering angles need to appear in pairs.\n
+   * @details The purpose of the current paramter is to filter out the angular area set by user\n
+   * @par example: Filters 10 degrees to 30 degrees and 80 degrees to 90 degrees.
+   * @code
+   *    CYdLidar laser;//Defining an CYdLidar instance.
+   *    std::vector<float> ignore_array;
+   *    ignore_array.push_back(10.0);
+   *    ignore_array.push_back(30.0);
+   *    ignore_array.push_back(80.0);
+   *    ignore_array.push_back(90.0);
+   *    laser.setIgnoreArray(ignore_array);
+   * @endcode
+   * @note The ignore ranges and the min/max angle window are compiled into
+   * a lookup table at ::AngleMaskResolution degrees on the next scan.
+   * @see CYdLidar::setIgnoreArray and CYdLidar::getIgnoreArray
+   */
+ private:
+  std::vector<float> m_IgnoreArray;
+ public:
+  void setIgnoreArray(const std::vector<float> &v);
+  inline std::vector<float> getIgnoreArray() {
+    return m_IgnoreArray;
+  }
+
+  PropertyBuilderByName(float, OffsetTime, private);
+  /**
+   * @brief Set and Get zero angle offset of each GS2 module in a merged frame.
+   * @note Element i is the offset of module i (address 1, 2, 4),
+   * missing elements are treated as zero.
+   * @remarks unit: degree
+   * @see CYdLidar::doProcessMerged
+   */
+  PropertyBuilderByName(std::vector<float>, ModuleAngleOffset, private);
+  /**
+   * @brief Set and Get what a merged frame does when a module packet is missing.
+   * @see ::MergePolicy and CYdLidar::doProcessMerged
+   */
+  PropertyBuilderByName(int, MergePolicy, private);
+  /**
+   * @brief Set and Get how long a merged frame waits for missing modules.
+   * @note Measured from the first packet of the frame.
+   * @remarks unit: ms
+   * @see CYdLidar::doProcessMerged
+   */
+  PropertyBuilderByName(int, MergeTimeout, private);
+  /**
+   * @brief Set and Get the file that raw serial data is recorded to.
+   * @note Empty disables recording. Recording starts before connecting,
+   * so the file can be replayed with ReplayFile.
+   * @see ydlidar::SerialRecorder
+   */
+  PropertyBuilderByName(std::string, RecordFile, private);
+  /**
+   * @brief Set and Get the recorded file that replaces the serial port.
+   * @note Empty uses the serial port. Commands sent to the LiDAR are discarded.
+   * @see ydlidar::ReplaySerial
+   */
+  PropertyBuilderByName(std::string, ReplayFile, private);
+  /**
+   * @brief Set and Get the replay speed of ReplayFile.
+   * @note 1 replays in real time, N at N times speed, 0 as fast as
+   * the data is read, which gives the same scans on every run.
+   */
+  PropertyBuilderByName(float, ReplaySpeed, private);
+  /**
+   * @brief Set and Get the file that caches module calibration per port.
+   * @note Empty disables the cache. With a cached entry for SerialPort,
+   * startup applies it without querying the modules; their identity and
+   * calibration are queried while scanning, and the calibration is reloaded
+   * and the cache rewritten if they differ. Not used with ReplayFile.
+   */
+  PropertyBuilderByName(std::string, CalibrationCache, private);
+  /**
+   * @brief Set and Get how each scan is corrected for sensor motion.
+   * @note Points are moved to the sensor frame at LaserScan::stamp using
+   * their timeOffsets. Motion comes from setDeskewPoseCallback or
+   * addDeskewTwist; a scan without motion data is returned uncorrected.
+   * @see ::DeskewMode
+   */
+  PropertyBuilderByName(int, DeskewMode, private);
+  /**
+   * @brief Set and Get LiDAR single channel.
+   * Whether LiDAR communication channel is a single-channel
+   * @note For a single-channel LiDAR, if the settings are reversed.\n
+   * an error will occur in obtaining device information and the LiDAR will Faied to Start.\n
+   * For dual-channel LiDAR, if th setttings are reversed.\n
+   * the device information cannot be obtained.\n
+   * Set the single channel to match the LiDAR.
+   * @remarks
+   <table>
+        <tr><th>G1/G2/G2A/G2C                          <td>false
+        <tr><th>G4/G4B/G4PRO/G6/F4/F4PRO               <td>false
+        <tr><th>S4/S4B/X4/R2/G4C                       <td>false
+        <tr><th>S2/X2/X2L                              <td>true
+        <tr><th>TG15/TG30/TG50                         <td>false
+        <tr><th>TX8/TX20                               <td>true
+        <tr><th>T5/T15                                 <td>false
+        <tr><th>                                       <td>true
+    </table>
+   * @see CYdLidar::setSingleChannel and CYdLidar::getSingleChannel
+   */
+  PropertyBuilderByName(bool, SingleChannel, private);
+  /**
+  * @brief Set and Get LiDAR Type.
+  * @note Refer to the table below for the LiDAR Type.\n
+  * Set the LiDAR Type to match the LiDAR.
+  * @remarks
+  <table>
+       <tr><th>G1/G2A/G2/G2C                    <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
+       <tr><th>G4/G4B/G4C/G4PRO                 <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
+       <tr><th>G6/F4/F4PRO                      <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
+       <tr><th>S4/S4B/X4/R2/S2/X2/X2L           <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
+       <tr><th>TG15/TG30/TG50/TX8/TX20          <td>[TYPE_TOF](\ref LidarTypeID::TYPE_TOF)
+       <tr><th>T5/T15                           <td>[TYPE_TOF_NET](\ref LidarTypeID::TYPE_TOF_NET)
+   </table>
+  * @see [LidarTypeID](\ref LidarTypeID)
+  * @see CYdLidar::setLidarType and CYdLidar::getLidarType
+  */
+  PropertyBuilderByName(int, LidarType, private);
+
+  PropertyBuilderByName(bool, Intensity,
+                          private) ///< 是否有信号质量
+
+ public:
+  CYdLidar(); //!< Constructor
+  virtual ~CYdLidar();  //!< Destructor: turns the laser off.
+  /*!
+   * @brief initialize
+   * @return
+   */
+  bool initialize();  //!< Attempts to connect and turns the laser on. Raises an exception on error.
+
+  // Return true if laser data acquistion succeeds, If it's not
+  // stamp is the capture time of the first point, timeOffsets holds each
+  // point's capture time relative to stamp. Capture times are smoothed
+  // against each module's packet period; monotonicStamp is stamp on the
+  // monotonic clock.
+  bool doProcessSimple(LaserScan &outscan,
+                       bool &hardwareError);
+
+  /*!
+   * @brief Same as doProcessSimple, output as separate angle/range/intensity arrays.
+   * @note The arrays keep their capacity, so reusing the same outscan
+   * does not allocate once the first scan has been filled.
+   */
+  bool doProcessSimple(LaserScanArrays &outscan,
+                       bool &hardwareError);
+
+  /*!
+   * @brief Same as doProcessSimple, output as x/y in the scan frame.
+   * @note Points come straight from the calibrated pixel coordinates, so
+   * no per-point trigonometry is done: the driver skips its angle/range
+   * transform while this output is in use, range limits are compared on
+   * squared range and angle limits on precomputed sector bounds. Packets
+   * queued meanwhile are transformed on demand when a polar output is
+   * requested again. Reversion, Inverted, AngleOffset,
+   * the angle limits, IgnoreArray and the range limits are applied as for
+   * polar output; filtered points are (0, 0). FixedResolution and
+   * DeskewMode do not apply.
+   */
+  bool doProcessSimple(LaserScanCartesian &outscan,
+                       bool &hardwareError);
+
+  /*!
+   * @brief Return one angle-ordered frame merged from all GS2 modules.
+   * @note Each module contributes one packet, rotated by its ModuleAngleOffset.
+   * Missing modules are handled according to MergePolicy and MergeTimeout.
+   * The merged scan has moduleNum ::MergedModuleNum and per-module stamps
+   * in LaserScan::moduleStamps; FixedResolution is not applied.
+   * stamp is the earliest point capture time and timeOffsets follow the
+   * angle order of points.
+   */
+  bool doProcessMerged(LaserScan &outscan,
+                       bool &hardwareError);
+
+  //Turn on the motor enable
+  bool  turnOn();  //!< See base class docs
+
+  //Turn off the motor enable and close the scan
+  bool  turnOff(); //!< See base class docs
+
+  //Turn off lidar connection
+  void disconnecting(); //!< Closes the comms with the laser. Shouldn't have to be directly needed by the user
+
+  //get zero angle offset value
+  float getAngleOffset() const;
+
+  //Whether the zero offset angle is corrected?
+  bool isAngleOffetCorrected() const;
+
+  //! get lidar software version
+  std::string getSoftVersion() const;
+
+  //! get lidar hardware version
+  std::string getHardwareVersion() const;
+
+  //! get lidar serial number
+  std::string getSerialNumber() const;
+
+  bool reset(uint8_t addr=0x01);
+
+  /*!
+   * @brief Reset several modules with a single serial write.
+   * @param mask module bits, bit0~bit2 for module 0~2 (address 1, 2, 4)
+   */
+  bool resetModules(uint8_t mask);
+
+  /*!
+   * @brief Get a snapshot of the acquisition counters and latency histogram.
+   * @note Safe to call from any thread; all counters are zero before
+   * initialize.
+   * @see ::LidarMetrics
+   */
+  void getMetrics(LidarMetrics &metrics) const;
+
+  //! reset the acquisition counters
+  void resetMetrics();
+
+  /*!
+   * @brief Set the pose interpolation callback used by ::DESKEW_POSE.
+   * @note Called from the thread calling doProcessSimple/doProcessMerged,
+   * twice per scan: at the scan stamp and at its last point.
+   */
+  void setDeskewPoseCallback(DeskewPoseFunc func, void *user);
+
+  /*!
+   * @brief Add a sensor velocity sample used by ::DESKEW_TWIST.
+   * @note Safe to call from any thread, e.g. an odometry callback.
+   */
+  void addDeskewTwist(const LidarTwist &twist);
+
+ protected:
+  /*! Returns true if communication has been established with the device. If it's not,
+    *  try to create a comms channel.
+    * \return false on error.
+    */
+  bool  checkCOMMs();
+
+  /*! Returns true if health status and device information has been obtained with the device. If it's not,
+    * \return false on error.
+    */
+  bool  checkStatus();
+
+  /*! Returns true if the normal scan runs with the device. If it's not,
+    * \return false on error.
+    */
+  bool checkHardware();
+
+  /*! returns true if the lidar data is normal, If it's not*/
+  bool checkLidarAbnormal();
+
+  /*!
+   * @brief checkCalibrationAngle
+   * @param serialNumber
+   */
+  void checkCalibrationAngle(const std::string &serialNumber);
+
+  /*!
+    * @brief isRangeValid
+    * @param reading
+    * @return
+    */
+  bool isRangeValid(double reading) const;
+
+  /*!
+   * @brief isRangeIgnore
+   * @param angle
+   * @return
+   */
+  bool isRangeIgnore(double angle) const;
+
+  /*!
+   * @brief 忽略角度和最小最大角度变化后重新生成角度查找表 \n
+   * 每::AngleMaskResolution 度一项, 完全在忽略区间内或角度范围外的项直接给出结果,
+   * 区间边界所在的项(含相邻项)标记为需要精确判断
+   */
+  void updateAngleMask();
+
+  /*!
+   * @brief 把激光点信息转换为输出点, 同::doProcessSimple
+   * @param[in] node        激光点信息
+   * @param[in] angleOffset 零位角度偏移[度]
+   * @param[out] point      输出点
+   * @return 点在最小最大角度范围内返回true
+   */
+  bool toLaserPoint(const GS2Point &node, float angleOffset,
+                    LaserPoint &point) const;
+
+  /*!
+   * @brief 按当前配置填写扫描参数
+   * @return 一帧输出点数(固定角度分辨率时为固定点数)
+   */
+  int fillScanConfig(LaserConfig &config, uint64_t scan_time, size_t count) const;
+
+  /*!
+   * @brief 输出当前合并帧并开始新的合并帧
+   * @return 输出返回true, 按MERGE_DROP丢弃不完整帧返回false
+   */
+  bool finishMergedFrame(LaserScan &outscan, bool complete);
+
+  /*!
+   * @brief 把scan_frame中的模组数据包加入当前合并帧
+   */
+  void addMergedModule(int moduleNum, uint64_t stamp);
+
+  /*!
+   * @brief 模组零位角度偏移[度]
+   */
+  float moduleAngleOffset(int moduleNum) const;
+
+  /*!
+   * @brief handleSingleChannelDevice
+   */
+  void handleSingleChannelDevice();
+
+  /**
+   * @brief parsePackageNode
+   * @param node
+   * @param info
+   */
+  void parsePackageNode(const node_info &node, LaserDebug &info);
+
+  /**
+   * @brief handleDeviceInfoPackage
+   * @param count
+   */
+  void handleDeviceInfoPackage(int count);
+
+  /**
+   * @brief printfVersionInfo
+   * @param info
+   */
+  void printfVersionInfo(const device_info &info);
+
+  /*!
+   * @brief Correct points of one scan for sensor motion, see DeskewMode.
+   * @param stamp reference time, capture time of time offset 0
+   * @param angles address of the first angle (float), strided by stride bytes
+   * @param ranges address of the first range (float), strided by stride bytes
+   * @param stride distance between consecutive points in bytes
+   * @param timeOffsets capture time of each point relative to stamp [s]
+   * @param count number of points
+   * @note Pass the point address plus offsetof() for packed point types
+   * instead of the address of a member.
+   */
+  void deskewScan(uint64_t stamp, void *angles, void *ranges, size_t stride,
+                  const float *timeOffsets, size_t count);
+
+ private:
+  bool    isScanning;
+  int     m_FixedSize ;
+  float   m_AngleOffset;
+  bool    m_isAngleOffsetCorrected;
+  float   frequencyOffset;
+  int   lidar_model;
+  uint8_t Major;
+  uint8_t Minjor;
+  YDlidarDriver *lidarPtr;
+  uint64_t m_PointTime;
+  uint64_t last_node_time;
+  node_info *global_nodes;      ///< 兼容接口的激光点信息, 见::checkLidarAbnormal
+  ModuleFrame scan_frame;       ///< 最近获取的模组数据包
+  std::vector<MergedLaserPoint> merge_points[PackageMaxModuleNums]; ///< 合并帧中各模组的点
+  std::vector<MergedLaserPoint> merge_sorted; ///< 合并帧按角度排序缓冲区
+  std::vector<float> merge_offsets; ///< 合并帧排序前各点时间偏移, 运动校正时使用
+  DeskewPoseFunc deskew_pose_func;  ///< 位姿插值回调
+  void    *deskew_pose_user;        ///< 位姿插值回调用户数据
+  TwistBuffer deskew_twists;        ///< 速度缓冲区
+  uint64_t merge_stamps[PackageMaxModuleNums]; ///< 合并帧中各模组数据包时间
+  std::vector<uint8_t> angle_mask; ///< 角度查找表, 见::AngleMaskFlag
+  bool     angle_mask_dirty;    ///< 忽略角度已修改
+  float    angle_mask_min;      ///< 生成查找表时的最小角度
+  float    angle_mask_max;      ///< 生成查找表时的最大角度
+  float    angle_mask_scale;    ///< 弧度到查找表序号的比例
+  std::vector<AngleSector> angle_sectors;  ///< 最小最大角度范围, 直角坐标输出时使用
+  std::vector<AngleSector> ignore_sectors; ///< 忽略区间, 直角坐标输出时使用
+  uint8_t  merge_mask;       ///< 合并帧中已有的模组
+  uint8_t  merge_seen_mask;  ///< 出现过的模组
+  uint64_t merge_start_time; ///< 合并帧第一个数据包时间
+  std::map<int, int> SampleRateMap;
+  bool m_ParseSuccess;
+  std::string m_lidarSoftVer;
+  std::string m_lidarHardVer;
+  std::string m_lidarSerialNum;
+  int defalutSampleRate;
+  int m_UserSampleRate;
+};	// End of class
+
@@ -86,6 +86,29 @@ static inline double normalize_angle(double angle) {
 }
 
 
+/*!
+ * \brief normalize_anglef
+ *
+ * Single precision ::normalize_angle, without fmod for angles already
+ * in range. It takes and returns radians.
+ *
+ */
+static inline float normalize_anglef(float angle) {
+  const float pi = static_cast<float>(M_PI);
+  const float two_pi = static_cast<float>(2.0 * M_PI);
+
+  if (angle > pi || angle <= -pi) {
+    angle -= two_pi * floorf((angle + pi) / two_pi);
+
+    if (angle <= -pi) {
+      angle += two_pi;
+    }
+  }
+
+  return angle;
+}
+
+
 /*!
  * \function
  * \brief shortest_angular_distance
@@ -0,0 +1,87 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "ydlidar_protocol.h"
+
+namespace ydlidar {
+
+/// 一个模组的缓存标定参数
+struct CalibrationEntry {
+  uint8_t        address;   ///< 模组地址(1, 2, 4)
+  std::string    identity;  ///< 模组标识, 版本应答的十六进制字符串
+  gs_device_para para;      ///< 标定参数, crc不使用
+};
+
+/*!
+* @brief 由模组版本应答生成模组标识
+* @param[in] data 应答数据, 不含校验和
+* @param[in] size 数据长度
+* @return 十六进制字符串, 数据为空时返回"-"
+*/
+std::string calibrationIdentity(const uint8_t *data, size_t size);
+
+/*!
+* @brief 读取缓存文件中一个端口的全部模组参数 \n
+* 文本格式, 每行一个模组: 端口 地址 标识 K0 B0 K1 B1 bias
+* @param[in]  path    缓存文件路径
+* @param[in]  port    串口名
+* @param[out] entries 该端口的模组参数, 按文件中的顺序
+* @return 文件不存在或没有该端口时返回false
+*/
+bool loadCalibrationCache(const std::string &path, const std::string &port,
+                          std::vector<CalibrationEntry> &entries);
+
+/*!
+* @brief 替换缓存文件中一个端口的全部模组参数, 保留其他端口 \n
+* 先写入临时文件再重命名, 写入中断不会损坏原文件
+* @param[in] path    缓存文件路径
+* @param[in] port    串口名, 不能包含空白字符
+* @param[in] entries 该端口的模组参数
+* @return 写入失败时返回false
+*/
+bool storeCalibrationCache(const std::string &path, const std::string &port,
+                           const std::vector<CalibrationEntry> &entries);
+
+/*!
+* @brief 比较两组模组参数, 不区分顺序, 不比较crc
+* @return 模组地址, 标识和标定参数都相同时返回true
+*/
+bool sameCalibration(const std::vector<CalibrationEntry> &a,
+                     const std::vector<CalibrationEntry> &b);
+
+} // namespace ydlidar
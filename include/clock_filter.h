@@ -0,0 +1,84 @@
+#pragma once
+#include <stdint.h>
+
+namespace ydlidar {
+
+/*!
+* 数据包到达时间滤波 \n
+* 模组按固定周期发送数据包, 到达时间 = 发送时间 + 传输及调度抖动.
+* 对窗口内的(数据包序号, 到达时间)做线性回归, 输出回归直线上的平滑时间,
+* 斜率即数据包周期, 可跟随传感器与主机的时钟漂移. \n
+* 序号按回归预测的周期数推算, 丢包不会打乱拟合; 偏离预测超过1/3周期的样本
+* (如串口积压后集中到达)不参与拟合, 连续偏离时重新开始拟合; 输出时间不递减
+* @note 输入输出使用单调时钟, 不在线程间共享
+*/
+class ClockFilter {
+ public:
+  enum {
+    WindowSize = 64,          ///< 拟合窗口大小
+    MinSamples = 8,           ///< 开始输出平滑时间所需的样本数
+    MaxRejects = WindowSize / 4, ///< 连续偏离预测超过此数时重新拟合
+  };
+
+  ClockFilter();
+
+  /*!
+  * @brief 清除全部样本, 如重新开始扫描时
+  */
+  void reset();
+
+  /*!
+  * @brief 输入一个数据包的到达时间
+  * @param[in] stamp 到达时间[ns]
+  * @return 平滑后的到达时间[ns], 样本不足时返回stamp
+  */
+  uint64_t update(uint64_t stamp);
+
+  /*!
+  * @brief 数据包周期估计[ns], 重新拟合期间保持上次的估计, 从未拟合时为0
+  */
+  uint64_t period() const;
+
+  /*!
+  * @brief 样本是否足够输出平滑时间
+  */
+  bool locked() const {
+    return count_ >= MinSamples;
+  }
+
+ private:
+  /*!
+  * @brief 清除拟合窗口, 保留上次输出时间和周期估计
+  */
+  void restart();
+
+  /*!
+  * @brief 输出不早于上次输出的时间
+  */
+  uint64_t output(uint64_t stamp);
+
+  /*!
+  * @brief 按当前窗口重新计算回归系数
+  */
+  void fit();
+
+  /*!
+  * @brief 回归直线在序号index处的时间, 相对base_
+  */
+  double predict(int64_t index) const;
+
+ private:
+  uint64_t base_;                 ///< 第一个样本的到达时间, 样本时间相对此值
+  int64_t  index_[WindowSize];    ///< 样本数据包序号
+  double   stamp_[WindowSize];    ///< 样本到达时间相对base_[ns]
+  int      head_;                 ///< 下一个样本写入位置
+  int      count_;                ///< 窗口内样本数
+  int      rejects_;              ///< 连续偏离预测的样本数
+  int64_t  last_index_;           ///< 最近一个样本的序号
+  double   slope_;                ///< 数据包周期[ns]
+  double   intercept_;            ///< 序号0处的时间[ns]
+  uint64_t last_output_;          ///< 上次输出的时间
+  uint64_t period_;               ///< 最近一次拟合的数据包周期[ns]
+};
+
+} // namespace ydlidar
@@ -0,0 +1,110 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+#pragma once
+#include "ydlidar_protocol.h"
+
+/// 批量换算与::YDlidarDriver::angTransform 的最大角度误差[度]
+#define GS2_TRANSFORM_ANGLE_TOLERANCE   0.01
+/// 批量换算与::YDlidarDriver::angTransform 的最大距离误差(angTransform输出取整)
+#define GS2_TRANSFORM_RANGE_TOLERANCE   1.0
+
+namespace ydlidar {
+
+/*!
+* GS2单个模组的标定查找表 \n
+* 像素坐标系下: X = dist, Y = (dist - Px) * k[n] + c[n]
+*/
+struct GS2TransformTable {
+  float k[PackageSampleMaxLngth_GS];    ///< (dist - Px)系数
+  float c[PackageSampleMaxLngth_GS];    ///< 偏移(-Py 或 +Py)
+};
+
+/// 批量换算指令集
+typedef enum {
+  TRANSFORM_ISA_SCALAR = 0,
+  TRANSFORM_ISA_SSE2,
+  TRANSFORM_ISA_AVX2,
+  TRANSFORM_ISA_NEON,
+  TRANSFORM_ISA_Tail,
+} TransformISA;
+
+/*!
+* @brief 批量换算函数
+* @param[in]  samples 数据包原始采样点, ::PackageSampleMaxLngth_GS 个
+* @param[in]  table   模组标定查找表
+* @param[out] theta   角度[度], 范围[0, 360), 距离为0的点输出0
+* @param[out] dist    距离, 距离为0的点输出0
+*/
+typedef void (*BatchTransformFunc)(const GS2PackageNode *samples,
+                                   const GS2TransformTable &table,
+                                   float *theta, float *dist);
+
+/*!
+* @brief 换算一个GS2数据包全部点的距离和角度 \n
+* 首次调用时按CPU支持情况选择AVX2/SSE2/NEON实现, 不支持时使用标量实现
+*/
+void batchTransform(const GS2PackageNode *samples,
+                    const GS2TransformTable &table,
+                    float *theta, float *dist);
+
+/*!
+* @brief 换算一个GS2数据包全部点在模组坐标系下的直角坐标 \n
+* 即::batchTransform 求角度和距离之前的中间结果, 不含三角函数和开方,
+* 由编译器自动向量化
+* @param[in]  samples 数据包原始采样点, ::PackageSampleMaxLngth_GS 个
+* @param[in]  table   模组标定查找表
+* @param[out] x       模组坐标系x, 与距离单位相同, 距离为0的点输出0
+* @param[out] y       模组坐标系y, 距离为0的点输出0
+*/
+void cartesianTransform(const GS2PackageNode *samples,
+                        const GS2TransformTable &table,
+                        float *x, float *y);
+
+/*!
+* @brief 获取指定指令集的批量换算函数
+* @return 当前编译器或CPU不支持时返回NULL
+*/
+BatchTransformFunc getBatchTransform(TransformISA isa);
+
+/*!
+* @brief 获取::batchTransform 当前使用的指令集
+*/
+TransformISA getBatchTransformISA();
+
+/*!
+* @brief 指令集名称
+*/
+const char *transformISAToString(TransformISA isa);
+
+}// namespace ydlidar
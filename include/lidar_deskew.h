@@ -0,0 +1,123 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "locker.h"
+
+namespace ydlidar {
+
+/// 运动畸变校正方式
+typedef enum {
+  DESKEW_OFF = 0,   ///< 不校正
+  DESKEW_POSE,      ///< 通过位姿插值回调获取运动, 见::DeskewPoseFunc
+  DESKEW_TWIST,     ///< 通过带时间戳的速度缓冲区获取运动, 见::TwistBuffer
+} DeskewMode;
+
+/*!
+* 雷达坐标系在里程计坐标系下的平面位姿 \n
+* 雷达坐标系与输出扫描一致: 0度为+x, 角度增大方向为+y
+*/
+struct LidarPose2D {
+  double x;       ///< [m]
+  double y;       ///< [m]
+  double theta;   ///< [rad]
+};
+
+/*!
+* 雷达坐标系下的平面速度
+*/
+struct LidarTwist {
+  uint64_t stamp; ///< 系统时间[ns], 与LaserScan::stamp 相同时钟
+  float vx;       ///< [m/s]
+  float vy;       ///< [m/s]
+  float wz;       ///< [rad/s]
+};
+
+/*!
+* @brief 位姿插值回调
+* @param[in]  stamp 系统时间[ns]
+* @param[out] pose  雷达在该时刻的位姿
+* @param[in]  user  注册回调时传入的用户数据
+* @return 无法获取该时刻位姿时返回false, 当前帧不校正
+*/
+typedef bool (*DeskewPoseFunc)(uint64_t stamp, LidarPose2D *pose, void *user);
+
+/*!
+* 一帧内的运动模型: 以参考时刻雷达坐标系表示的恒定速度 \n
+* t时刻雷达相对参考时刻的位姿为 dθ = wz * t,
+* d = R(dθ / 2) * (vx, vy) * t * sinc(dθ / 2)
+*/
+struct DeskewMotion {
+  float vx;       ///< 距离单位/s
+  float vy;       ///< 距离单位/s
+  float wz;       ///< [rad/s]
+};
+
+/*!
+* 带时间戳的速度缓冲区 \n
+* 里程计线程调用::push, 采集线程调用::motion, 内部加锁
+*/
+class TwistBuffer {
+ public:
+  enum {
+    Capacity = 256,               ///< 缓冲区容量, 超出时覆盖最早的速度
+  };
+
+  /// 查询时刻超出缓冲区时间范围的最大容许值[ns]
+  static const uint64_t MaxExtrapolation = 100000000ULL;
+
+  TwistBuffer();
+
+  /*!
+  * @brief 加入一个速度, 时间戳早于上一个速度时清空缓冲区
+  */
+  void push(const LidarTwist &twist);
+
+  /*!
+  * @brief 清空缓冲区
+  */
+  void clear();
+
+  /*!
+  * @brief 按[from, to]中间时刻插值速度
+  * @param[in]  from 起始时间[ns]
+  * @param[in]  to   结束时间[ns]
+  * @param[out] motion 运动模型, 速度单位为m/s
+  * @return 缓冲区为空或中间时刻距缓冲区时间范围超过::MaxExtrapolation 时返回false
+  */
+  bool motion(uint64_t from, uint64_t to, DeskewMotion &motion) const;
+
+ private:
+  LidarTwist      twists_[Capacity];  ///< 环形缓冲区
+  size_t          head_;              ///< 下一个写入位置
+  size_t          count_;             ///< 速度个数
+  mutable Locker  lock_;
+};
+
+/*!
+* @brief 由参考时刻和结束时刻的位姿计算运动模型
+* @param[in]  ref      参考时刻位姿
+* @param[in]  end      结束时刻位姿
+* @param[in]  duration 两个时刻的间隔[s], 需大于0
+* @param[out] motion   运动模型, 速度单位为m/s
+*/
+void deskewMotionFromPoses(const LidarPose2D &ref, const LidarPose2D &end,
+                           double duration, DeskewMotion &motion);
+
+/*!
+* @brief 将每个点校正到参考时刻的雷达坐标系 \n
+* 角度和距离按stride字节间隔存放, 不要求对齐, 可直接处理LaserPoint数组
+* (首点地址加offsetof(LaserPoint, angle), 避免取packed成员地址)或分开的数组.
+* x86下使用SSE2每次处理4个点, 其他平台使用标量实现
+* @param[in,out] angles      第一个点的角度(float)[rad], 输出范围[-π, π]
+* @param[in,out] ranges      第一个点的距离(float), 距离不大于0的点不处理
+* @param[in]     stride      相邻点的间隔[字节]
+* @param[in]     timeOffsets 各点采集时间相对参考时刻的偏移[s], 连续存放
+* @param[in]     count       点数
+* @param[in]     motion      运动模型, 速度单位需与距离单位一致
+*/
+void deskewPoints(void *angles, void *ranges, size_t stride,
+                  const float *timeOffsets, size_t count,
+                  const DeskewMotion &motion);
+
+} // namespace ydlidar
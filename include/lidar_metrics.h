@@ -0,0 +1,233 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+#include "ydlidar_protocol.h"
+
+/// 延时直方图桶数, 第0个桶为[0, 1)us, 第i个桶为[2^(i-1), 2^i)us, 最后一个桶不设上限
+#define LatencyBucketNums 24
+
+/*!
+* 采集流程运行指标快照
+* @see ::MetricsRecorder
+*/
+struct LidarMetrics {
+  uint64_t bytes_received;                  ///< 从串口读取的字节数
+  uint64_t packets[PackageMaxModuleNums];   ///< 各模组校验通过的数据包数
+  uint64_t checksum_errors;                 ///< 校验和错误的数据包数
+  uint64_t resync_bytes;                    ///< 同步包头时跳过的字节数
+  uint64_t timeouts;                        ///< 等待数据包超时次数
+  uint64_t dropped_frames;                  ///< 数据包队列满时丢弃的数据包数
+  uint64_t reconnects;                      ///< 自动重连成功次数
+  uint64_t latency_count;                   ///< 延时样本数
+  uint64_t latency_sum;                     ///< 延时总和[ns]
+  uint64_t latency[LatencyBucketNums];      ///< 从串口读取到::grabScanData 返回的延时直方图
+  uint64_t wait_surplus_count;              ///< 串口等待余量样本数
+  uint64_t wait_surplus_sum;                ///< 串口等待余量总和[ns]
+  uint64_t wait_surplus[LatencyBucketNums]; ///< 串口等待返回时超出所需的字节数, 按线路传输时间换算的直方图
+
+  /*!
+  * @brief 平均延时[ns]
+  */
+  uint64_t latencyMean() const {
+    return latency_count ? latency_sum / latency_count : 0;
+  }
+
+  /*!
+  * @brief 延时分位数, 精度为直方图桶宽
+  * @param[in] p 分位(0 ~ 1)
+  * @return 所在桶的上限[ns], 落在最后一个桶时返回其下限
+  */
+  uint64_t latencyPercentile(double p) const {
+    return percentile(latency, latency_count, p);
+  }
+
+  /*!
+  * @brief 平均串口等待余量[ns]
+  */
+  uint64_t waitSurplusMean() const {
+    return wait_surplus_count ? wait_surplus_sum / wait_surplus_count : 0;
+  }
+
+  /*!
+  * @brief 串口等待余量分位数, 同::latencyPercentile
+  */
+  uint64_t waitSurplusPercentile(double p) const {
+    return percentile(wait_surplus, wait_surplus_count, p);
+  }
+
+ private:
+  static uint64_t percentile(const uint64_t *hist, uint64_t count, double p) {
+    uint64_t rank = uint64_t(p * count);
+    uint64_t sum = 0;
+
+    for (int i = 0; i < LatencyBucketNums - 1; i++) {
+      sum += hist[i];
+
+      if (sum > rank) {
+        return (1ULL << i) * 1000;
+      }
+    }
+
+    return count ? (1ULL << (LatencyBucketNums - 2)) * 1000 : 0;
+  }
+};
+
+/*!
+* 采集流程运行指标计数 \n
+* 记录只使用relaxed原子操作, 可在任意线程通过::snapshot 读取
+*/
+class MetricsRecorder {
+ public:
+  MetricsRecorder() {
+    reset();
+  }
+
+  void addBytes(size_t size) {
+    add(bytes_received, size);
+  }
+
+  /*!
+  * @param[in] mdNum 模组序号(0, 1, 2)
+  */
+  void addPacket(uint8_t mdNum) {
+    if (mdNum < PackageMaxModuleNums) {
+      add(packets[mdNum], 1);
+    }
+  }
+
+  void addChecksumError() {
+    add(checksum_errors, 1);
+  }
+
+  void addResyncBytes(size_t size) {
+    if (size) {
+      add(resync_bytes, size);
+    }
+  }
+
+  void addTimeout() {
+    add(timeouts, 1);
+  }
+
+  void addDroppedFrame() {
+    add(dropped_frames, 1);
+  }
+
+  void addReconnect() {
+    add(reconnects, 1);
+  }
+
+  /*!
+  * @param[in] ns 延时[ns]
+  */
+  void addLatency(uint64_t ns) {
+    add(latency[bucket(ns)], 1);
+    add(latency_count, 1);
+    add(latency_sum, ns);
+  }
+
+  /*!
+  * @param[in] ns 串口等待余量[ns]
+  */
+  void addWaitSurplus(uint64_t ns) {
+    add(wait_surplus[bucket(ns)], 1);
+    add(wait_surplus_count, 1);
+    add(wait_surplus_sum, ns);
+  }
+
+  /*!
+  * @brief 读取当前指标, 各计数器分别读取, 相互之间不保证一致
+  */
+  void snapshot(LidarMetrics &metrics) const {
+    metrics.bytes_received = bytes_received.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < PackageMaxModuleNums; i++) {
+      metrics.packets[i] = packets[i].load(std::memory_order_relaxed);
+    }
+
+    metrics.checksum_errors = checksum_errors.load(std::memory_order_relaxed);
+    metrics.resync_bytes = resync_bytes.load(std::memory_order_relaxed);
+    metrics.timeouts = timeouts.load(std::memory_order_relaxed);
+    metrics.dropped_frames = dropped_frames.load(std::memory_order_relaxed);
+    metrics.reconnects = reconnects.load(std::memory_order_relaxed);
+    metrics.latency_count = latency_count.load(std::memory_order_relaxed);
+    metrics.latency_sum = latency_sum.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < LatencyBucketNums; i++) {
+      metrics.latency[i] = latency[i].load(std::memory_order_relaxed);
+    }
+
+    metrics.wait_surplus_count =
+      wait_surplus_count.load(std::memory_order_relaxed);
+    metrics.wait_surplus_sum = wait_surplus_sum.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < LatencyBucketNums; i++) {
+      metrics.wait_surplus[i] = wait_surplus[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  /*!
+  * @brief 清零全部指标
+  */
+  void reset() {
+    bytes_received.store(0, std::memory_order_relaxed);
+
+    for (int i = 0; i < PackageMaxModuleNums; i++) {
+      packets[i].store(0, std::memory_order_relaxed);
+    }
+
+    checksum_errors.store(0, std::memory_order_relaxed);
+    resync_bytes.store(0, std::memory_order_relaxed);
+    timeouts.store(0, std::memory_order_relaxed);
+    dropped_frames.store(0, std::memory_order_relaxed);
+    reconnects.store(0, std::memory_order_relaxed);
+    latency_count.store(0, std::memory_order_relaxed);
+    latency_sum.store(0, std::memory_order_relaxed);
+
+    for (int i = 0; i < LatencyBucketNums; i++) {
+      latency[i].store(0, std::memory_order_relaxed);
+    }
+
+    wait_surplus_count.store(0, std::memory_order_relaxed);
+    wait_surplus_sum.store(0, std::memory_order_relaxed);
+
+    for (int i = 0; i < LatencyBucketNums; i++) {
+      wait_surplus[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  /*!
+  * @brief 延时所在直方图桶
+  */
+  static int bucket(uint64_t ns) {
+    uint64_t us = ns / 1000;
+    int index = 0;
+
+    while (us && index < LatencyBucketNums - 1) {
+      us >>= 1;
+      index++;
+    }
+
+    return index;
+  }
+
+  static void add(std::atomic<uint64_t> &counter, uint64_t value) {
+    counter.fetch_add(value, std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<uint64_t> bytes_received;
+  std::atomic<uint64_t> packets[PackageMaxModuleNums];
+  std::atomic<uint64_t> checksum_errors;
+  std::atomic<uint64_t> resync_bytes;
+  std::atomic<uint64_t> timeouts;
+  std::atomic<uint64_t> dropped_frames;
+  std::atomic<uint64_t> reconnects;
+  std::atomic<uint64_t> latency_count;
+  std::atomic<uint64_t> latency_sum;
+  std::atomic<uint64_t> latency[LatencyBucketNums];
+  std::atomic<uint64_t> wait_surplus_count;
+  std::atomic<uint64_t> wait_surplus_sum;
+  std::atomic<uint64_t> wait_surplus[LatencyBucketNums];
+};
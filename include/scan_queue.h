@@ -0,0 +1,187 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+#include "locker.h"
+#include "ydlidar_protocol.h"
+
+/*!
+* 一个模组的一包激光数据
+*/
+struct ModuleFrame {
+  uint64_t  seq;                                ///< 序号, 包含溢出丢弃的数据包
+  size_t    count;                              ///< 激光点数
+  uint64_t  recv_stamp;                         ///< 从串口读取到数据包的单调时钟时间[ns]
+  int64_t   clock_offset;                       ///< 读取时系统时间与单调时钟之差[ns]
+  uint64_t  last_stamp;                         ///< 最后一个点的采集时间的系统时间[ns]
+  uint64_t  point_time;                         ///< 相邻两点的采样间隔[ns]
+  uint8_t   module;                             ///< 模组序号(0, 1, 2)
+  uint8_t   index;                              ///< 数据包计数, 校验和错误时为0xff
+  bool      polar;                              ///< points已换算角度距离
+  bool      cartesian;                          ///< x, y已换算直角坐标
+  GS2Point  points[PackageSampleMaxLngth_GS];   ///< 激光点信息
+  GS2PackageNode samples[PackageSampleMaxLngth_GS]; ///< 原始采样点, 校验和错误时为0
+  float     x[PackageSampleMaxLngth_GS];        ///< 模组坐标系x, 见::YDlidarDriver::cartesianPoints
+  float     y[PackageSampleMaxLngth_GS];        ///< 模组坐标系y
+
+  /*!
+  * @brief 第i个点的采集时间的系统时间[ns]
+  */
+  uint64_t stamp(size_t i) const {
+    return last_stamp - (PackageSampleMaxLngth_GS - 1 - i) * point_time;
+  }
+};
+
+/*!
+* 单生产者/单消费者无锁数据包队列 \n
+* 数据包预先分配, 生产者在队列满时丢弃最新数据包并计数
+* @note 生产者只调用::beginWrite/::commitWrite/::waitWritable,
+* 消费者只调用::front/::pop/::wait
+*/
+class ScanQueue {
+ public:
+  enum {
+    Capacity = 16, ///< 队列容量, 必须为2的幂
+  };
+
+  ScanQueue() : _head(0), _tail(0), _seq(0), _dropped(0), _waiting(false),
+    _writer_waiting(false) {}
+
+  /*!
+  * @brief 获取下一个可写的数据包(生产者)
+  * @return 队列满时返回NULL, 并计入溢出丢弃数
+  */
+  ModuleFrame *beginWrite() {
+    uint64_t seq = _seq++;
+    size_t tail = _tail.load(std::memory_order_relaxed);
+
+    if (tail - _head.load(std::memory_order_acquire) >= Capacity) {
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return NULL;
+    }
+
+    ModuleFrame *frame = &_frames[tail & (Capacity - 1)];
+    frame->seq = seq;
+    return frame;
+  }
+
+  /*!
+  * @brief 提交::beginWrite 获取的数据包, 唤醒等待的消费者(生产者)
+  */
+  void commitWrite() {
+    _tail.store(_tail.load(std::memory_order_relaxed) + 1,
+                std::memory_order_seq_cst);
+
+    if (_waiting.exchange(false, std::memory_order_seq_cst)) {
+      _event.set();
+    }
+  }
+
+  /*!
+  * @brief 队首数据包(消费者)
+  * @return 队列空时返回NULL
+  */
+  const ModuleFrame *front() const {
+    size_t head = _head.load(std::memory_order_relaxed);
+
+    if (head == _tail.load(std::memory_order_acquire)) {
+      return NULL;
+    }
+
+    return &_frames[head & (Capacity - 1)];
+  }
+
+  /*!
+  * @brief 释放队首数据包(消费者)
+  */
+  void pop() {
+    _head.store(_head.load(std::memory_order_relaxed) + 1,
+                std::memory_order_seq_cst);
+
+    if (_writer_waiting.exchange(false, std::memory_order_seq_cst)) {
+      _space_event.set();
+    }
+  }
+
+  /*!
+  * @brief 等待队列非空(消费者)
+  * @param[in] timeout 超时时间
+  * @return 同::Event::wait, 被::notify 唤醒时队列可能仍为空
+  */
+  unsigned long wait(unsigned long timeout) {
+    _waiting.store(true, std::memory_order_seq_cst);
+
+    if (_head.load(std::memory_order_relaxed) !=
+        _tail.load(std::memory_order_seq_cst)) {
+      _waiting.store(false, std::memory_order_relaxed);
+      return Event::EVENT_OK;
+    }
+
+    return _event.wait(timeout);
+  }
+
+  /*!
+  * @brief 队列有空位(生产者)
+  */
+  bool writable() const {
+    return _tail.load(std::memory_order_relaxed) -
+           _head.load(std::memory_order_acquire) < Capacity;
+  }
+
+  /*!
+  * @brief 等待队列有空位(生产者) \n
+  * 不允许丢弃数据包时(如尽快回放录制数据)在::beginWrite 之前调用
+  * @param[in] timeout 超时时间
+  * @return 同::Event::wait, 之前::pop 留下的事件或::notify 唤醒时队列可能仍为满,
+  * 返回后用::writable 检查
+  */
+  unsigned long waitWritable(unsigned long timeout) {
+    _writer_waiting.store(true, std::memory_order_seq_cst);
+
+    if (_tail.load(std::memory_order_relaxed) -
+        _head.load(std::memory_order_seq_cst) < Capacity) {
+      _writer_waiting.store(false, std::memory_order_relaxed);
+      return Event::EVENT_OK;
+    }
+
+    return _space_event.wait(timeout);
+  }
+
+  /*!
+  * @brief 唤醒等待的消费者和生产者
+  */
+  void notify() {
+    _event.set();
+    _space_event.set();
+  }
+
+  /*!
+  * @brief 清空队列
+  * @note 生产者和消费者都停止时调用
+  */
+  void clear() {
+    _head.store(0);
+    _tail.store(0);
+    _waiting.store(false);
+    _writer_waiting.store(false);
+    _event.set(false);
+    _space_event.set(false);
+  }
+
+  /*!
+  * @brief 队列满时丢弃的数据包数
+  */
+  uint64_t dropped() const {
+    return _dropped.load(std::memory_order_relaxed);
+  }
+
+ private:
+  ModuleFrame           _frames[Capacity];
+  std::atomic<size_t>   _head;
+  std::atomic<size_t>   _tail;
+  uint64_t              _seq;
+  std::atomic<uint64_t> _dropped;
+  std::atomic<bool>     _waiting;
+  std::atomic<bool>     _writer_waiting;
+  Event                 _event;
+  Event                 _space_event;
+};
@@ -0,0 +1,169 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+#pragma once
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <atomic>
+#include "serial.h"
+#include "locker.h"
+
+/// 串口录制文件标识
+#define SERIAL_RECORD_MAGIC     "YDSERREC"
+/// 串口录制文件版本
+#define SERIAL_RECORD_VERSION   1
+/// 串口录制数据块最大长度, 读取时超过则视为文件损坏
+#define SERIAL_RECORD_MAX_CHUNK 65536
+
+namespace ydlidar {
+
+#if defined(_WIN32)
+#pragma pack(1)
+#endif
+
+/*!
+* 串口录制文件头, 之后为若干数据块: ::SerialRecordChunk + size字节原始数据 \n
+* 全部字段为小端序
+*/
+struct SerialRecordHeader {
+  char     magic[8];  ///< ::SERIAL_RECORD_MAGIC
+  uint32_t version;   ///< ::SERIAL_RECORD_VERSION
+  uint32_t baudrate;  ///< 录制时波特率
+} __attribute__((packed));
+
+/*!
+* 录制数据块头
+*/
+struct SerialRecordChunk {
+  uint64_t stamp;     ///< 读取到数据的单调时钟时间[ns], 只用于回放节奏
+  uint32_t size;      ///< 数据大小, 不大于::SERIAL_RECORD_MAX_CHUNK
+} __attribute__((packed));
+
+#if defined(_WIN32)
+#pragma pack()
+#endif
+
+/*!
+* 串口原始数据录制 \n
+* 按读取顺序保存驱动从串口读到的全部数据及读取时间
+*/
+class SerialRecorder {
+ public:
+  SerialRecorder();
+  ~SerialRecorder();
+
+  /*!
+  * @brief 创建录制文件
+  * @param[in] path     文件路径
+  * @param[in] baudrate 串口波特率
+  * @return 成功返回true
+  */
+  bool open(const std::string &path, uint32_t baudrate);
+
+  /*!
+  * @brief 关闭录制文件
+  */
+  void close();
+
+  bool isOpen() const;
+
+  /*!
+  * @brief 以当前时间录制一块数据
+  */
+  void write(const uint8_t *data, size_t size);
+
+ private:
+  FILE    *file_;
+  Locker  lock_;
+};
+
+/*!
+* 回放::SerialRecorder 录制文件的串口 \n
+* 按录制时的到达时间间隔提供数据, 写入的命令被丢弃
+*/
+class ReplaySerial : public serial::Serial {
+ public:
+  /*!
+  * @param[in] path  录制文件路径
+  * @param[in] speed 回放速度, 1为实时, N为N倍速, 0为尽快回放 \n
+  * 尽快回放时只在::waitfordata 等待数据时提供下一块, 结果只取决于读取顺序
+  */
+  explicit ReplaySerial(const std::string &path, double speed = 1.0);
+  virtual ~ReplaySerial();
+
+  virtual bool open();
+  virtual bool isOpen();
+  virtual void closePort();
+  virtual size_t available();
+  virtual int waitfordata(size_t data_count, uint32_t timeout,
+                          size_t *returned_size);
+  virtual void cancelWait();
+  virtual void clearCancelWait();
+  /// 回放数据没有传输时间, 始终返回false
+  virtual bool getWaitSurplus(uint64_t &ns) const;
+  virtual size_t readData(uint8_t *data, size_t size);
+  virtual size_t writeData(const uint8_t *data, size_t size);
+  virtual void flush();
+  virtual bool setDTR(bool level = true);
+  virtual int getByteTime();
+
+  /*!
+  * @brief 录制数据已全部读完
+  */
+  bool eof();
+
+ private:
+  bool load();
+  /// 按回放时间提供已到达的数据块, 返回可读数据大小
+  size_t release();
+
+ private:
+  std::string          path_;
+  double               speed_;
+  std::atomic<bool>    is_open_;
+  bool                 loaded_;
+  uint32_t             baudrate_;
+  std::vector<uint8_t> data_;       ///< 全部录制数据
+  std::vector<SerialRecordChunk> chunks_;
+  std::vector<size_t>  offsets_;    ///< 各数据块在data_中的位置
+  size_t               next_chunk_; ///< 下一个未提供的数据块
+  size_t               read_pos_;   ///< data_中下一个可读字节
+  size_t               end_pos_;    ///< data_中已提供数据的结束位置
+  uint64_t             play_start_; ///< 回放开始时的单调时钟时间
+  uint64_t             record_start_; ///< 回放开始时对应的录制时间
+  std::atomic<bool>    cancel_;     ///< ::cancelWait 请求, 下一次等待时清除
+  Locker               lock_;
+};
+
+}// namespace ydlidar
@@ -101,22 +101,12 @@ class Thread {
 
 #else
     UNUSED(timeout);
-    void *res;
-    int s = -1;
-    s = pthread_cancel((pthread_t)(this->_handle));
-
-    if (s != 0) {
-    }
-
-    s = pthread_join((pthread_t)(this->_handle), &res);
-
-    if (s != 0) {
+    //线程需自行退出, 强制结束使用::terminate
+    if (pthread_join((pthread_t)(this->_handle), NULL) != 0) {
+      return -2;
     }
 
-    if (res == PTHREAD_CANCELED) {
-      printf("%lu thread has been canceled\n", this->_handle);
-      this->_handle = 0;
-    }
+    this->_handle = 0;
 
 #endif
     return 0;
@@ -1,540 +1,872 @@
-﻿/*********************************************************************
-* Software License Agreement (BSD License)
-*
-*  Copyright (c) 2018, EAIBOT, Inc.
-*  All rights reserved.
-*
-*  Redistribution and use in source and binary forms, with or without
-*  modification, are permitted provided that the following conditions
-*  are met:
-*
-*   * Redistributions of source code must retain the above copyright
-*     notice, this list of conditions and the following disclaimer.
-*   * Redistributions in binary form must reproduce the above
-*     copyright notice, this list of conditions and the following
-*     disclaimer in the documentation and/or other materials provided
-*     with the distribution.
-*   * Neither the name of the Willow Garage nor the names of its
-*     contributors may be used to endorse or promote products derived
-*     from this software without specific prior written permission.
-*
-*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
-*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
-*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
-*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
-*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
-*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
-*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
-*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
-*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
-*  POSSIBILITY OF SUCH DAMAGE.
-*********************************************************************/
-
-/** @page YDlidarDriver
- * YDlidarDriver API
-    <table>
-        <tr><th>Library     <td>YDlidarDriver
-        <tr><th>File        <td>ydlidar_driver.h
-        <tr><th>Author      <td>Tony [code at ydlidar com]
-        <tr><th>Source      <td>https://github.com/ydlidar/YDLidar-SDK
-        <tr><th>Version     <td>1.0.0
-    </table>
-    This YDlidarDriver support [TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE) and [TYPE_TOF](\ref LidarTypeID::TYPE_TOF) LiDAR
-
-* @copyright    Copyright (c) 2018-2020  EAIBOT
-     Jump to the @link ::ydlidar::YDlidarDriver @endlink interface documentation.
-*/
-#ifndef YDLIDAR_DRIVER_H
-#define YDLIDAR_DRIVER_H
-#include <stdlib.h>
-#include <atomic>
-#include <map>
-#include "serial.h"
-#include "locker.h"
-#include "thread.h"
-#include "ydlidar_protocol.h"
-#include "help_info.h"
-
-#if !defined(__cplusplus)
-#ifndef __cplusplus
-#error "The YDLIDAR SDK requires a C++ compiler to be built"
-#endif
-#endif
-
-
-using namespace std;
-using namespace serial;
-
-namespace ydlidar {
-
-/*!
-* Class that provides a lidar interface.
-*/
-class YDlidarDriver {
- public:
-  /**
-    * @brief Set and Get LiDAR single channel.
-    * Whether LiDAR communication channel is a single-channel
-    * @note For a single-channel LiDAR, if the settings are reversed.\n
-    * an error will occur in obtaining device information and the LiDAR will Faied to Start.\n
-    * For dual-channel LiDAR, if th setttings are reversed.\n
-    * the device information cannot be obtained.\n
-    * Set the single channel to match the LiDAR.
-    * @remarks
-    <table>
-         <tr><th>G1/G2/G2A/G2C                          <td>false
-         <tr><th>G4/G4B/G4PRO/G6/F4/F4PRO               <td>false
-         <tr><th>S4/S4B/X4/R2/G4C                       <td>false
-         <tr><th>S2/X2/X2L                              <td>true
-         <tr><th>TG15/TG30/TG50                         <td>false
-         <tr><th>TX8/TX20                               <td>true
-         <tr><th>T5/T15                                 <td>false
-         <tr><th>                                       <td>true
-     </table>
-    * @see DriverInterface::setSingleChannel and DriverInterface::getSingleChannel
-    */
-  PropertyBuilderByName(bool, SingleChannel, private);
-  /**
-  * @brief Set and Get LiDAR Type.
-  * @note Refer to the table below for the LiDAR Type.\n
-  * Set the LiDAR Type to match the LiDAR.
-  * @remarks
-  <table>
-       <tr><th>G1/G2A/G2/G2C                    <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
-       <tr><th>G4/G4B/G4C/G4PRO                 <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
-       <tr><th>G6/F4/F4PRO                      <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
-       <tr><th>S4/S4B/X4/R2/S2/X2/X2L           <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
-       <tr><th>TG15/TG30/TG50/TX8/TX20          <td>[TYPE_TOF](\ref LidarTypeID::TYPE_TOF)
-       <tr><th>T5/T15                           <td>[TYPE_TOF_NET](\ref LidarTypeID::TYPE_TOF_NET)
-   </table>
-  * @see [LidarTypeID](\ref LidarTypeID)
-  * @see DriverInterface::setLidarType and DriverInterface::getLidarType
-  */
-  PropertyBuilderByName(int, LidarType, private);
-  /**
-  * @brief Set and Get Sampling interval.
-  * @note Negative correlation between sampling interval and lidar sampling rate.\n
-  * sampling interval = 1e9 / sampling rate(/s)\n
-  * Set the LiDAR sampling interval to match the LiDAR.
-  * @see DriverInterface::setPointTime and DriverInterface::getPointTime
-  */
-  PropertyBuilderByName(uint32_t, PointTime,private);
-  /*!
-  * A constructor.
-  * A more elaborate description of the constructor.
-  */
-  YDlidarDriver();
-
-  /*!
-  * A destructor.
-  * A more elaborate description of the destructor.
-  */
-  virtual ~YDlidarDriver();
-
-  /*!
-  * @brief 连接雷达 \n
-  * 连接成功后，必须使用::disconnect函数关闭
-  * @param[in] port_path    串口号
-  * @param[in] baudrate    波特率，YDLIDAR-SS雷达波特率：
-  *     230400 G2-SS-1
-  * @return 返回连接状态
-  * @retval 0     成功
-  * @retval < 0   失败
-  * @note连接成功后，必须使用::disconnect函数关闭
-  * @see 函数::YDlidarDriver::disconnect (“::”是指定有连接功能,可以看文档里的disconnect变成绿,点击它可以跳转到disconnect.)
-  */
-  result_t connect(const char *port_path, uint32_t baudrate);
-
-  /*!
-  * @brief 断开雷达连接
-  */
-  void disconnect();
-
-  /*!
-  * @brief 获取当前SDK版本号 \n
-  * 静态函数
-  * @return 返回当前SKD 版本号
-  */
-  static std::string getSDKVersion();
-
-  /*!
-  * @brief lidarPortList 获取雷达端口
-  * @return 在线雷达列表
-  */
-  static std::map<std::string, std::string> lidarPortList();
-
-  //打印数据
-  static void printHex(const uint8_t* data, int size);
-
-  /*!
-  * @brief 扫图状态 \n
-  * @return 返回当前雷达扫图状态
-  * @retval true     正在扫图
-  * @retval false    扫图关闭
-  */
-  bool isscanning() const;
-
-  /*!
-  * @brief 连接雷达状态 \n
-  * @return 返回连接状态
-  * @retval true     成功
-  * @retval false    失败
-  */
-  bool isconnected() const;
-
-  /*!
-  * @brief 设置雷达是否带信号质量 \n
-  * 连接成功后，必须使用::disconnect函数关闭
-  * @param[in] isintensities    是否带信号质量:
-  *     true	带信号质量
-  *	  false 无信号质量
-  * @note只有S4B(波特率是153600)雷达支持带信号质量, 别的型号雷达暂不支持
-  */
-  void setIntensities(const bool &isintensities);
-
-  /*!
-  * @brief 设置雷达异常自动重新连接 \n
-  * @param[in] enable    是否开启自动重连:
-  *     true	开启
-  *	  false 关闭
-  */
-  void setAutoReconnect(const bool &enable);
-
-  /*!
-  * @brief 获取雷达设备信息 \n
-  * @param[in] parameters     设备信息
-  * @param[in] timeout  超时时间
-  * @return 返回执行结果
-  * @retval RESULT_OK       获取成功
-  * @retval RESULT_FAILE or RESULT_TIMEOUT   获取失败
-  */
-  result_t getDevicePara(gs_device_para &info,   uint32_t timeout = DEFAULT_TIMEOUT);
-
-  /*!
- * @brief 配置雷达地址 \n
- * @param[in] timeout  超时时间
- * @return 返回执行结果
- * @retval RESULT_OK       配置成功
- * @retval RESULT_FAILE or RESULT_TIMEOUT   配置超时
- */
-  result_t setDeviceAddress(uint32_t timeout = DEFAULT_TIMEOUT);
-
-  /*!
-  * @brief 开启扫描 \n
-  * @param[in] force    扫描模式
-  * @param[in] timeout  超时时间
-  * @return 返回执行结果
-  * @retval RESULT_OK       开启成功
-  * @retval RESULT_FAILE    开启失败
-  * @note 只用开启一次成功即可
-  */
-  result_t startScan(bool force = false, uint32_t timeout = DEFAULT_TIMEOUT);
-
-  /*!
-  * @brief 关闭扫描 \n
-  * @return 返回执行结果
-  * @retval RESULT_OK       关闭成功
-  * @retval RESULT_FAILE    关闭失败
-  */
-  result_t stop();
-
-  /*!
-  * @brief 获取激光数据 \n
-  * @param[in] nodebuffer 激光点信息
-  * @param[in] count      一圈激光点数
-  * @param[in] timeout    超时时间
-  * @return 返回执行结果
-  * @retval RESULT_OK       获取成功
-  * @retval RESULT_FAILE    获取失败
-  * @note 获取之前，必须使用::startScan函数开启扫描
-  */
-  result_t grabScanData(node_info *nodebuffer, size_t &count,
-                        uint32_t timeout = DEFAULT_TIMEOUT) ;
-
-
-  /*!
-  * @brief 补偿激光角度 \n
-  * 把角度限制在0到360度之间
-  * @param[in] nodebuffer 激光点信息
-  * @param[in] count      一圈激光点数
-  * @return 返回执行结果
-  * @retval RESULT_OK       成功
-  * @retval RESULT_FAILE    失败
-  * @note 补偿之前，必须使用::grabScanData函数获取激光数据成功
-  */
-  result_t ascendScanData(node_info *nodebuffer, size_t count);
-
-  /*!
-  * @brief 重置激光雷达 \n
-  * @param[in] timeout      超时时间
-  * @return 返回执行结果
-  * @retval RESULT_OK       成功
-  * @retval RESULT_FAILE    失败
-  * @note 停止扫描后再执行当前操作, 如果在扫描中调用::stop函数停止扫描
-  */
-  result_t reset(uint8_t addr, uint32_t timeout = DEFAULT_TIMEOUT);
-
- protected:
-
-  /*!
-  * @brief 创建解析雷达数据线程 \n
-  * @note 创建解析雷达数据线程之前，必须使用::startScan函数开启扫图成功
-  */
-  result_t createThread();
-
-
-  /*!
-  * @brief 重新连接开启扫描 \n
-  * @param[in] force    扫描模式
-  * @param[in] timeout  超时时间
-  * @return 返回执行结果
-  * @retval RESULT_OK       开启成功
-  * @retval RESULT_FAILE    开启失败
-  * @note sdk 自动重新连接调用
-  */
-  result_t startAutoScan(bool force = false, uint32_t timeout = DEFAULT_TIMEOUT) ;
-
-  /*!
-  * @brief stopScan
-  * @param timeout
-  * @return
-  */
-  result_t stopScan(uint32_t timeout = DEFAULT_TIMEOUT);
-
-  /*!
-   * @brief waitDevicePackage
-   * @param timeout
-   * @return
-   */
-  result_t waitDevicePackage(uint32_t timeout = DEFAULT_TIMEOUT);
-  /*!
-  * @brief 解包激光数据 \n
-  * @param[in] node 解包后激光点信息
-  * @param[in] timeout     超时时间
-  */
-  result_t waitPackage(node_info *node, uint32_t timeout = DEFAULT_TIMEOUT);
-
-  /*!
-  * @brief 发送数据到雷达 \n
-  * @param[in] nodebuffer 激光信息指针
-  * @param[in] count      激光点数大小
-  * @param[in] timeout      超时时间
-  * @return 返回执行结果
-  * @retval RESULT_OK       成功
-  * @retval RESULT_TIMEOUT  等待超时
-  * @retval RESULT_FAILE    失败
-  */
-  result_t waitScanData(node_info *nodebuffer, size_t &count,
-                        uint32_t timeout = DEFAULT_TIMEOUT);
-
-  /*!
-  * @brief 激光数据解析线程 \n
-  */
-  int cacheScanData();
-
-  /*!
-  * @brief 发送数据到雷达 \n
-  * @param[in] cmd 	 命名码
-  * @param[in] payload      payload
-  * @param[in] payloadsize      payloadsize
-  * @return 返回执行结果
-  * @retval RESULT_OK       成功
-  * @retval RESULT_FAILE    失败
-  */
-  result_t sendCommand(uint8_t cmd,
-                       const void *payload = NULL,
-                       size_t payloadsize = 0);
-
-  /*!
-  * @brief 发送数据到雷达 \n
-  * @param[in] addr 模组地址
-  * @param[in] cmd 	 命名码
-  * @param[in] payload      payload
-  * @param[in] payloadsize      payloadsize
-  * @return 返回执行结果
-  * @retval RESULT_OK       成功
-  * @retval RESULT_FAILE    失败
-  */
-  result_t sendCommand(uint8_t addr,
-                       uint8_t cmd,
-                       const void *payload = NULL,
-                       size_t payloadsize = 0);
-
-  /*!
-  * @brief 等待激光数据包头 \n
-  * @param[in] header 	 包头
-  * @param[in] timeout      超时时间
-  * @return 返回执行结果
-  * @retval RESULT_OK       获取成功
-  * @retval RESULT_TIMEOUT  等待超时
-  * @retval RESULT_FAILE    获取失败
-  * @note 当timeout = -1 时, 将一直等待
-  */
-  result_t waitResponseHeader(gs_lidar_ans_header *header,
-                              uint32_t timeout = DEFAULT_TIMEOUT);
-
-  /*!
-  * @brief 等待固定数量串口数据 \n
-  * @param[in] data_count 	 等待数据大小
-  * @param[in] timeout    	 等待时间
-  * @param[in] returned_size   实际数据大小
-  * @return 返回执行结果
-  * @retval RESULT_OK       获取成功
-  * @retval RESULT_TIMEOUT  等待超时
-  * @retval RESULT_FAILE    获取失败
-  * @note 当timeout = -1 时, 将一直等待
-  */
-  result_t waitForData(size_t data_count, uint32_t timeout = DEFAULT_TIMEOUT,
-                       size_t *returned_size = NULL);
-
-  /*!
-  * @brief 获取串口数据 \n
-  * @param[in] data 	 数据指针
-  * @param[in] size    数据大小
-  * @return 返回执行结果
-  * @retval RESULT_OK       获取成功
-  * @retval RESULT_FAILE    获取失败
-  */
-  result_t getData(uint8_t *data, size_t size);
-
-  /*!
-  * @brief 串口发送数据 \n
-  * @param[in] data 	 发送数据指针
-  * @param[in] size    数据大小
-  * @return 返回执行结果
-  * @retval RESULT_OK       发送成功
-  * @retval RESULT_FAILE    发送失败
-  */
-  result_t sendData(const uint8_t *data, size_t size);
-
-
-  /*!
-  * @brief checkTransDelay
-  */
-  void checkTransDelay();
-
-  /*!
-  * @brief 关闭数据获取通道 \n
-  */
-  void disableDataGrabbing();
-
-  /*!
-  * @brief 设置串口DTR \n
-  */
-  void setDTR();
-
-  /*!
-  * @brief 清除串口DTR \n
-  */
-  void clearDTR();
-
-  /*!
-   * @brief flushSerial
-   */
-  void flushSerial();
-
-  /*!
-   * @brief checkAutoConnecting
-   */
-  result_t checkAutoConnecting();
-
-  /*!
-   * @brief  换算得出点的距离和角度
-   */
-  void angTransform(uint16_t dist, int n, double *dstTheta, uint16_t *dstDist);
-
-  void addPointsToVec(node_info *nodebuffer, size_t &count);
-
- public:
-  std::atomic<bool>     isConnected;  ///< 串口连接状体
-  std::atomic<bool>     isScanning;   ///< 扫图状态
-  std::atomic<bool>     isAutoReconnect;  ///< 异常自动从新连接
-  std::atomic<bool>     isAutoconnting;  ///< 是否正在自动连接中
-
-
-  enum {
-    DEFAULT_TIMEOUT = 2000,    /**< 默认超时时间. */
-    DEFAULT_HEART_BEAT = 1000, /**< 默认检测掉电功能时间. */
-    MAX_SCAN_NODES = 3600,	   /**< 最大扫描点数. */
-    DEFAULT_TIMEOUT_COUNT = 1,
-  };
-
-  node_info      *scan_node_buf;    ///< 激光点信息
-  size_t         scan_node_count;   ///< 激光点数
-  Event          _dataEvent;        ///< 数据同步事件
-  Locker         _lock;				///< 线程锁
-  Locker         _serial_lock;		///< 串口锁
-  Thread 	     _thread;		   ///< 线程id
-
- private:
-  int PackageSampleBytes;            ///< 一个包包含的激光点数
-  serial::Serial *_serial;			///< 串口
-  bool m_intensities;				///< 信号质量状体
-  uint32_t m_baudrate;				///< 波特率
-  bool isSupportMotorDtrCtrl;	    ///< 是否支持电机控制
-  uint32_t trans_delay;				///< 串口传输一个byte时间
-  int m_sampling_rate;              ///< 采样频率
-  int model;                        ///< 雷达型号
-  int sample_rate;                  ///<
-
-  gs2_node_package package;             ///< 带信号质量协议包
-
-  uint16_t package_Sample_Index;    ///< 包采样点索引
-  float IntervalSampleAngle;
-  float IntervalSampleAngle_LastPackage;
-  uint8_t CheckSum;                ///< 校验和
-  uint8_t scan_frequence;           ///< 协议中雷达转速
-
-  uint8_t CheckSumCal;
-  uint16_t SampleNumlAndCTCal;
-  uint16_t LastSampleAngleCal;
-  bool CheckSumResult;
-  uint16_t Valu8Tou16;
-
-  std::string serial_port;///< 雷达端口
-  uint8_t *globalRecvBuffer;
-  int retryCount;
-  bool has_device_header;
-  uint8_t last_device_byte;
-  int         asyncRecvPos;
-  uint16_t    async_size;
-
-  //singleChannel
-  device_info info_;
-  device_health health_;
-  gs_lidar_ans_header header_;
-  uint8_t  *headerBuffer;
-  uint8_t  *infoBuffer;
-  uint8_t  *healthBuffer;
-  bool     get_device_info_success;
-  bool     get_device_health_success;
-
-  int package_index;
-  uint8_t package_type;
-  bool has_package_error;
-
-  double  d_compensateK0[PackageMaxModuleNums];
-  double  d_compensateK1[PackageMaxModuleNums];
-  double  d_compensateB0[PackageMaxModuleNums];
-  double  d_compensateB1[PackageMaxModuleNums];
-  uint16_t  u_compensateK0[PackageMaxModuleNums];
-  uint16_t  u_compensateK1[PackageMaxModuleNums];
-  uint16_t  u_compensateB0[PackageMaxModuleNums];    
-  uint16_t  u_compensateB1[PackageMaxModuleNums];
-  double  bias[PackageMaxModuleNums];
-  bool isValidPoint;
-  uint8_t  package_Sample_Num;
-
-  uint8_t   frameNum;  //帧序号
-  uint8_t   moduleNum;  //模块编号
-  bool      isPrepareToSend; //是否准备好发送
-
-  std::vector<GS2_Multi_Package>  multi_package;
-
-};
-
-}// namespace ydlidar
-
-#endif // YDLIDAR_DRIVER_H
+﻿/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+
+/** @page YDlidarDriver
+ * YDlidarDriver API
+    <table>
+        <tr><th>Library     <td>YDlidarDriver
+        <tr><th>File        <td>ydlidar_driver.h
+        <tr><th>Author      <td>Tony [code at ydlidar com]
+        <tr><th>Source      <td>https://github.com/ydlidar/YDLidar-SDK
+        <tr><th>Version     <td>1.0.0
+    </table>
+    This YDlidarDriver support [TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE) and [TYPE_TOF](\ref LidarTypeID::TYPE_TOF) LiDAR
+
+* @copyright    Copyright (c) 2018-2020  EAIBOT
+     Jump to the @link ::ydlidar::YDlidarDriver @endlink interface documentation.
+*/
+#ifndef YDLIDAR_DRIVER_H
+#define YDLIDAR_DRIVER_H
+#include <stdlib.h>
+#include <atomic>
+#include <map>
+#include "serial.h"
+#include "locker.h"
+#include "thread.h"
+#include "ydlidar_protocol.h"
+#include "help_info.h"
+#include "gs2_transform.h"
+#include "scan_queue.h"
+#include "serial_record.h"
+#include "lidar_metrics.h"
+#include "ydlidar_log.h"
+#include "ydlidar_trace.h"
+#include "clock_filter.h"
+#include "calibration_cache.h"
+
+#if !defined(__cplusplus)
+#ifndef __cplusplus
+#error "The YDLIDAR SDK requires a C++ compiler to be built"
+#endif
+#endif
+
+
+using namespace std;
+using namespace serial;
+
+namespace ydlidar {
+
+/*!
+* Class that provides a lidar interface.
+*/
+class YDlidarDriver {
+ public:
+  /**
+    * @brief Set and Get LiDAR single channel.
+    * Whether LiDAR communication channel is a single-channel
+    * @note For a single-channel LiDAR, if the settings are reversed.\n
+    * an error will occur in obtaining device information and the LiDAR will Faied to Start.\n
+    * For dual-channel LiDAR, if th setttings are reversed.\n
+    * the device information cannot be obtained.\n
+    * Set the single channel to match the LiDAR.
+    * @remarks
+    <table>
+         <tr><th>G1/G2/G2A/G2C                          <td>false
+         <tr><th>G4/G4B/G4PRO/G6/F4/F4PRO               <td>false
+         <tr><th>S4/S4B/X4/R2/G4C                       <td>false
+         <tr><th>S2/X2/X2L                              <td>true
+         <tr><th>TG15/TG30/TG50                         <td>false
+         <tr><th>TX8/TX20                               <td>true
+         <tr><th>T5/T15                                 <td>false
+         <tr><th>                                       <td>true
+     </table>
+    * @see DriverInterface::setSingleChannel and DriverInterface::getSingleChannel
+    */
+  PropertyBuilderByName(bool, SingleChannel, private);
+  /**
+  * @brief Set and Get LiDAR Type.
+  * @note Refer to the table below for the LiDAR Type.\n
+  * Set the LiDAR Type to match the LiDAR.
+  * @remarks
+  <table>
+       <tr><th>G1/G2A/G2/G2C                    <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
+       <tr><th>G4/G4B/G4C/G4PRO                 <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
+       <tr><th>G6/F4/F4PRO                      <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
+       <tr><th>S4/S4B/X4/R2/S2/X2/X2L           <td>[TYPE_TRIANGLE](\ref LidarTypeID::TYPE_TRIANGLE)
+       <tr><th>TG15/TG30/TG50/TX8/TX20          <td>[TYPE_TOF](\ref LidarTypeID::TYPE_TOF)
+       <tr><th>T5/T15                           <td>[TYPE_TOF_NET](\ref LidarTypeID::TYPE_TOF_NET)
+   </table>
+  * @see [LidarTypeID](\ref LidarTypeID)
+  * @see DriverInterface::setLidarType and DriverInterface::getLidarType
+  */
+  PropertyBuilderByName(int, LidarType, private);
+  /**
+  * @brief Set and Get Sampling interval.
+  * @note Negative correlation between sampling interval and lidar sampling rate.\n
+  * sampling interval = 1e9 / sampling rate(/s)\n
+  * Set the LiDAR sampling interval to match the LiDAR.
+  * @see DriverInterface::setPointTime and DriverInterface::getPointTime
+  */
+  PropertyBuilderByName(uint32_t, PointTime,private);
+  /*!
+  * A constructor.
+  * A more elaborate description of the constructor.
+  */
+  YDlidarDriver();
+
+  /*!
+  * A destructor.
+  * A more elaborate description of the destructor.
+  */
+  virtual ~YDlidarDriver();
+
+  /*!
+  * @brief 连接雷达 \n
+  * 连接成功后，必须使用::disconnect函数关闭
+  * @param[in] port_path    串口号
+  * @param[in] baudrate    波特率，YDLIDAR-SS雷达波特率：
+  *     230400 G2-SS-1
+  * @return 返回连接状态
+  * @retval 0     成功
+  * @retval < 0   失败
+  * @note连接成功后，必须使用::disconnect函数关闭
+  * @see 函数::YDlidarDriver::disconnect (“::”是指定有连接功能,可以看文档里的disconnect变成绿,点击它可以跳转到disconnect.)
+  */
+  result_t connect(const char *port_path, uint32_t baudrate);
+
+  /*!
+  * @brief 断开雷达连接
+  */
+  void disconnect();
+
+  /*!
+  * @brief 使用指定串口代替::connect 创建的串口, 例如::ReplaySerial \n
+  * 在::connect 之前调用, 驱动负责释放
+  * @param[in] serial   串口
+  * @param[in] lossless 数据包队列满时等待::grabScanData 而不丢弃数据包,
+  * 用于尽快回放录制数据
+  */
+  void setSerial(serial::Serial *serial, bool lossless = false);
+
+  /*!
+  * @brief 开始录制从串口读取的原始数据 \n
+  * 在::connect 之前调用时同时录制连接过程
+  * @param[in] path     录制文件路径
+  * @param[in] baudrate 串口波特率
+  * @return 成功返回true
+  * @see ::ReplaySerial
+  */
+  bool startRecording(const std::string &path, uint32_t baudrate);
+
+  /*!
+  * @brief 停止录制
+  */
+  void stopRecording();
+
+  /*!
+  * @brief 设置标定参数缓存文件 \n
+  * ::startScan 时有当前端口的缓存则直接使用, 不再查询标定参数;
+  * 扫描开始后在后台查询模组标识和标定参数, 与缓存不同时更新查找表和缓存.
+  * 使用::setSerial 设置的串口时不使用缓存
+  * @param[in] path 缓存文件路径, 为空时不使用缓存
+  */
+  void setCalibrationCache(const std::string &path);
+
+  /*!
+  * @brief 获取当前SDK版本号 \n
+  * 静态函数
+  * @return 返回当前SKD 版本号
+  */
+  static std::string getSDKVersion();
+
+  /*!
+  * @brief lidarPortList 获取雷达端口
+  * @return 在线雷达列表
+  */
+  static std::map<std::string, std::string> lidarPortList();
+
+  //打印数据
+  static void printHex(const uint8_t* data, int size);
+
+  /*!
+  * @brief 扫图状态 \n
+  * @return 返回当前雷达扫图状态
+  * @retval true     正在扫图
+  * @retval false    扫图关闭
+  */
+  bool isscanning() const;
+
+  /*!
+  * @brief 连接雷达状态 \n
+  * @return 返回连接状态
+  * @retval true     成功
+  * @retval false    失败
+  */
+  bool isconnected() const;
+
+  /*!
+  * @brief 设置雷达是否带信号质量 \n
+  * 连接成功后，必须使用::disconnect函数关闭
+  * @param[in] isintensities    是否带信号质量:
+  *     true	带信号质量
+  *	  false 无信号质量
+  * @note只有S4B(波特率是153600)雷达支持带信号质量, 别的型号雷达暂不支持
+  */
+  void setIntensities(const bool &isintensities);
+
+  /*!
+  * @brief 设置雷达异常自动重新连接 \n
+  * @param[in] enable    是否开启自动重连:
+  *     true	开启
+  *	  false 关闭
+  */
+  void setAutoReconnect(const bool &enable);
+
+  /*!
+  * @brief 获取雷达设备信息 \n
+  * 扫描中调用时由采集线程转交应答并更新标定参数, 扫描不中断
+  * @param[in] parameters     设备信息, 模组2(地址4)的参数
+  * @param[in] timeout  超时时间
+  * @return 返回执行结果
+  * @retval RESULT_OK       全部模组返回了参数
+  * @retval RESULT_FAILE or RESULT_TIMEOUT   获取失败或有模组未应答
+  * @see 获取各模组参数使用::getDevicePara(gs_device_para *, uint8_t &, uint32_t)
+  */
+  result_t getDevicePara(gs_device_para &info,   uint32_t timeout = DEFAULT_TIMEOUT);
+
+  /*!
+  * @brief 获取各模组标定参数 \n
+  * 扫描中调用时由采集线程转交应答并更新标定参数, 扫描不中断
+  * @param[out] infos   各模组参数, 按模组序号存放, 长度::PackageMaxModuleNums
+  * @param[out] mask    返回了参数的模组掩码, 第i位表示模组i(地址1, 2, 4)
+  * @param[in]  timeout 超时时间
+  * @return 返回执行结果
+  * @retval RESULT_OK       至少一个模组返回了参数, 未应答的模组见mask
+  * @retval RESULT_FAILE or RESULT_TIMEOUT   获取失败或没有模组应答
+  */
+  result_t getDevicePara(gs_device_para *infos, uint8_t &mask,
+                         uint32_t timeout = DEFAULT_TIMEOUT);
+
+  /*!
+  * @brief 获取返回了标定参数的模组 \n
+  * @return 模组掩码, 第i位表示模组i(地址1, 2, 4), 未获取过参数时返回0
+  */
+  uint8_t getModuleMask() const;
+
+  /*!
+ * @brief 配置雷达地址 \n
+ * 扫描中调用时由采集线程转交应答, 扫描不中断
+ * @param[in] timeout  超时时间
+ * @return 返回执行结果
+ * @retval RESULT_OK       配置成功
+ * @retval RESULT_FAILE or RESULT_TIMEOUT   配置超时
+ */
+  result_t setDeviceAddress(uint32_t timeout = DEFAULT_TIMEOUT);
+
+  /*!
+  * @brief 开启扫描 \n
+  * @param[in] force    扫描模式
+  * @param[in] timeout  超时时间
+  * @return 返回执行结果
+  * @retval RESULT_OK       开启成功
+  * @retval RESULT_FAILE    开启失败
+  * @note 只用开启一次成功即可
+  */
+  result_t startScan(bool force = false, uint32_t timeout = DEFAULT_TIMEOUT);
+
+  /*!
+  * @brief 关闭扫描 \n
+  * @return 返回执行结果
+  * @retval RESULT_OK       关闭成功
+  * @retval RESULT_FAILE    关闭失败
+  */
+  result_t stop();
+
+  /*!
+  * @brief 获取激光数据 \n
+  * @param[in] nodebuffer 激光点信息
+  * @param[in] count      一圈激光点数
+  * @param[in] timeout    超时时间
+  * @return 返回执行结果
+  * @retval RESULT_OK       获取成功
+  * @retval RESULT_FAILE    获取失败
+  * @retval RESULT_TIMEOUT  等待超时
+  * @note 获取之前，必须使用::startScan函数开启扫描
+  */
+  result_t grabScanData(node_info *nodebuffer, size_t &count,
+                        uint32_t timeout = DEFAULT_TIMEOUT) ;
+
+  /*!
+  * @brief 获取一个模组的一包激光数据, 不展开为::node_info \n
+  * @param[out] frame   数据包
+  * @param[in]  timeout 超时时间
+  * @return 同::grabScanData
+  */
+  result_t grabScanData(ModuleFrame &frame, uint32_t timeout = DEFAULT_TIMEOUT);
+
+  /*!
+  * @brief 确保数据包的frame.x, frame.y为模组坐标系下的直角坐标 \n
+  * 由原始采样点和标定表直接换算, 不经过角度距离换算; 关闭角度距离换算时
+  * 采集线程已换算, 否则在调用线程补算
+  * @param[in,out] frame 数据包, 距离为0的点输出0
+  */
+  void cartesianPoints(ModuleFrame &frame);
+
+  /*!
+  * @brief 设置采集线程换算各点的角度和距离还是直角坐标 \n
+  * 只使用::cartesianPoints 时关闭, 省去批量换算的三角函数和开方;
+  * 重新开启后::grabScanData 补算关闭期间入队的数据包
+  * @param[in] enable 是否换算, 默认开启
+  */
+  void setPolarTransform(bool enable);
+
+  /*!
+  * @brief 把数据包展开为::node_info, 用于兼容接口
+  * @param[in]  frame 数据包
+  * @param[out] nodes 激光点信息, 大小不小于count
+  * @param[in]  count 展开的点数, 不大于frame.count
+  */
+  static void toNodeInfo(const ModuleFrame &frame, node_info *nodes, size_t count);
+
+  /*!
+  * @brief 最近一次::grabScanData 获取的数据包序号 \n
+  * 序号不连续说明消费过慢, 中间的数据包已被丢弃
+  */
+  uint64_t getScanSequence() const;
+
+  /*!
+  * @brief 最近一次::grabScanData 获取的数据包读取时系统时间与单调时钟之差[ns] \n
+  * 激光点时间戳为系统时间, 减去此值得到单调时钟时间
+  */
+  int64_t getScanClockOffset() const;
+
+  /*!
+  * @brief 消费过慢导致数据包队列满而丢弃的数据包总数
+  */
+  uint64_t getDroppedScanCount() const;
+
+  /*!
+  * @brief 获取运行指标, 可在任意线程调用
+  * @param[out] metrics 指标快照
+  */
+  void getMetrics(LidarMetrics &metrics) const;
+
+  /*!
+  * @brief 清零运行指标
+  */
+  void resetMetrics();
+
+
+  /*!
+  * @brief 补偿激光角度 \n
+  * 把角度限制在0到360度之间
+  * @param[in] nodebuffer 激光点信息
+  * @param[in] count      一圈激光点数
+  * @return 返回执行结果
+  * @retval RESULT_OK       成功
+  * @retval RESULT_FAILE    失败
+  * @note 补偿之前，必须使用::grabScanData函数获取激光数据成功
+  */
+  result_t ascendScanData(node_info *nodebuffer, size_t count);
+
+  /*!
+  * @brief 重置激光雷达 \n
+  * @param[in] timeout      超时时间
+  * @return 返回执行结果
+  * @retval RESULT_OK       成功
+  * @retval RESULT_FAILE    失败
+  * @note 停止扫描后再执行当前操作, 如果在扫描中调用::stop函数停止扫描
+  */
+  result_t reset(uint8_t addr, uint32_t timeout = DEFAULT_TIMEOUT);
+
+  /*!
+  * @brief 重置多个模组, 复位命令一次写入串口 \n
+  * @param[in] mask     模组掩码, bit0~bit2 对应模组0~2, 同::getModuleMask
+  * @param[in] timeout  超时时间
+  * @return 返回执行结果
+  * @retval RESULT_OK       成功
+  * @retval RESULT_FAILE    失败
+  * @note 停止扫描后再执行当前操作
+  */
+  result_t resetModules(uint8_t mask, uint32_t timeout = DEFAULT_TIMEOUT);
+
+  /*!
+  * @brief 发送一批命令 \n
+  * 所有命令组帧到同一缓冲区后一次写入串口, 不等待应答
+  * @param[in] commands 命令
+  * @param[in] count    命令数
+  * @return 返回执行结果
+  * @retval RESULT_OK       成功
+  * @retval RESULT_FAILE    失败
+  */
+  result_t sendCommands(const LidarCommand *commands, size_t count);
+
+ protected:
+
+  /*!
+  * @brief 创建解析雷达数据线程 \n
+  * @note 创建解析雷达数据线程之前，必须使用::startScan函数开启扫图成功
+  */
+  result_t createThread();
+
+
+  /*!
+  * @brief 重新连接开启扫描 \n
+  * @param[in] force    扫描模式
+  * @param[in] timeout  超时时间
+  * @return 返回执行结果
+  * @retval RESULT_OK       开启成功
+  * @retval RESULT_FAILE    开启失败
+  * @note sdk 自动重新连接调用
+  */
+  result_t startAutoScan(bool force = false, uint32_t timeout = DEFAULT_TIMEOUT) ;
+
+  /*!
+  * @brief stopScan
+  * @param timeout
+  * @return
+  */
+  result_t stopScan(uint32_t timeout = DEFAULT_TIMEOUT);
+
+  /*!
+   * @brief waitDevicePackage
+   * @param timeout
+   * @return
+   */
+  result_t waitDevicePackage(uint32_t timeout = DEFAULT_TIMEOUT);
+  /*!
+  * @brief 解包一个完整的GS2激光数据包 \n
+  * 在接收缓冲区中查找包头, 缓冲区内数据满一整包(::NORMAL_PACKAGE_SIZE)后直接校验解包, 输出包内全部激光点
+  * @param[in] nodebuffer 解包后激光点信息, 大小不小于::PackageSampleMaxLngth_GS
+  * @param[in] count      解包后激光点数
+  * @param[in] timeout     超时时间
+  * @return 返回执行结果
+  * @retval RESULT_OK       获取成功
+  * @retval RESULT_TIMEOUT  等待超时
+  * @retval RESULT_FAIL     获取失败
+  * @note 各点采集时间见::packageLastStamp 和::packagePointTime
+  */
+  result_t waitPackage(GS2Point *nodebuffer, size_t &count,
+                       uint32_t timeout = DEFAULT_TIMEOUT);
+
+  /*!
+  * @brief 解析数据包内全部激光点 \n
+  * @param[in] package    完整数据包
+  * @param[in] nodebuffer 解包后激光点信息, 大小不小于::PackageSampleMaxLngth_GS
+  * @note 校验和错误的数据包输出无效点
+  */
+  void parsePackage(const gs2_node_package &package, GS2Point *nodebuffer);
+
+  /*!
+  * @brief 由原始采样点换算各点的角度和距离
+  * @param[in]  samples    原始采样点, ::PackageSampleMaxLngth_GS 个
+  * @param[in]  mdNum      模组序号(0, 1, 2)
+  * @param[out] nodebuffer 激光点信息, 大小不小于::PackageSampleMaxLngth_GS
+  */
+  void transformPoints(const GS2PackageNode *samples, uint8_t mdNum,
+                       GS2Point *nodebuffer) const;
+
+  /*!
+  * @brief 模组相邻两点的采样间隔[ns] \n
+  * 模组数据包周期未知时使用::PointTime
+  */
+  uint64_t modulePointTime(uint8_t mdNum) const;
+
+  /*!
+  * @brief 清除各模组数据包到达时间滤波
+  */
+  void resetModuleClock();
+
+  /*!
+  * @brief 保证接收缓冲区内至少有size字节未处理数据 \n
+  * 不足时等待串口数据, 并一次读取串口当前全部可读数据(不超过缓冲区剩余空间)
+  * @param[in] size     需要的数据大小, 不大于::RecvBufferSize
+  * @param[in] timeout  超时时间
+  * @return 返回执行结果
+  * @retval RESULT_OK       获取成功
+  * @retval RESULT_TIMEOUT  等待超时
+  * @retval RESULT_FAIL     获取失败
+  */
+  result_t fillRecvBuffer(size_t size, uint32_t timeout);
+
+  /*!
+  * @brief 在接收缓冲区未处理数据中查找包头同步字(A5 A5 A5 A5) \n
+  * 找到时同步字前的数据被丢弃; 未找到时只保留末尾可能属于同步字的数据
+  * @return 缓冲区头部为完整同步字时返回true
+  */
+  bool syncRecvBuffer();
+
+  /*!
+  * @brief 发送数据到雷达 \n
+  * @param[in] nodebuffer 激光信息指针
+  * @param[in] count      激光点数大小
+  * @param[in] timeout      超时时间
+  * @return 返回执行结果
+  * @retval RESULT_OK       成功
+  * @retval RESULT_TIMEOUT  等待超时
+  * @retval RESULT_FAILE    失败
+  */
+  result_t waitScanData(GS2Point *nodebuffer, size_t &count,
+                        uint32_t timeout = DEFAULT_TIMEOUT);
+
+  /*!
+  * @brief 激光数据解析线程 \n
+  */
+  int cacheScanData();
+
+  /*!
+  * @brief 发送数据到雷达 \n
+  * @param[in] cmd 	 命名码
+  * @param[in] payload      payload
+  * @param[in] payloadsize      payloadsize
+  * @return 返回执行结果
+  * @retval RESULT_OK       成功
+  * @retval RESULT_FAILE    失败
+  */
+  result_t sendCommand(uint8_t cmd,
+                       const void *payload = NULL,
+                       size_t payloadsize = 0);
+
+  /*!
+  * @brief 发送数据到雷达 \n
+  * @param[in] addr 模组地址
+  * @param[in] cmd 	 命名码
+  * @param[in] payload      payload
+  * @param[in] payloadsize      payloadsize
+  * @return 返回执行结果
+  * @retval RESULT_OK       成功
+  * @retval RESULT_FAILE    失败
+  */
+  result_t sendCommand(uint8_t addr,
+                       uint8_t cmd,
+                       const void *payload = NULL,
+                       size_t payloadsize = 0);
+
+  /*!
+  * @brief 将命令组帧后一次写入串口, 调用者需持有::_lock \n
+  * @param[in] commands 命令
+  * @param[in] count    命令数
+  * @return 返回执行结果
+  * @retval RESULT_OK       成功
+  * @retval RESULT_FAILE    失败
+  */
+  result_t writeCommands(const LidarCommand *commands, size_t count);
+
+  /*!
+  * @brief 命令组帧 \n
+  * @param[in]  command 命令
+  * @param[out] frame   帧缓冲区, 长度不小于::commandFrameSize
+  * @return 帧长度
+  */
+  static size_t frameCommand(const LidarCommand &command, uint8_t *frame);
+
+  /*!
+  * @brief 命令帧长度
+  */
+  static size_t commandFrameSize(const LidarCommand &command);
+
+  /*!
+  * @brief 等待激光数据包头 \n
+  * @param[in] header 	 包头
+  * @param[in] timeout      超时时间
+  * @return 返回执行结果
+  * @retval RESULT_OK       获取成功
+  * @retval RESULT_TIMEOUT  等待超时
+  * @retval RESULT_FAILE    获取失败
+  * @note 当timeout = -1 时, 将一直等待
+  */
+  result_t waitResponseHeader(gs_lidar_ans_header *header,
+                              uint32_t timeout = DEFAULT_TIMEOUT);
+
+  /*!
+  * @brief 等待固定数量串口数据 \n
+  * @param[in] data_count 	 等待数据大小
+  * @param[in] timeout    	 等待时间
+  * @param[in] returned_size   实际数据大小
+  * @return 返回执行结果
+  * @retval RESULT_OK       获取成功
+  * @retval RESULT_TIMEOUT  等待超时
+  * @retval RESULT_FAILE    获取失败
+  * @note 当timeout = -1 时, 将一直等待
+  */
+  result_t waitForData(size_t data_count, uint32_t timeout = DEFAULT_TIMEOUT,
+                       size_t *returned_size = NULL);
+
+  /*!
+  * @brief 获取串口数据 \n
+  * @param[in] data 	 数据指针
+  * @param[in] size    数据大小
+  * @return 返回执行结果
+  * @retval RESULT_OK       获取成功
+  * @retval RESULT_FAILE    获取失败
+  */
+  result_t getData(uint8_t *data, size_t size);
+
+  /*!
+  * @brief 串口发送数据 \n
+  * @param[in] data 	 发送数据指针
+  * @param[in] size    数据大小
+  * @return 返回执行结果
+  * @retval RESULT_OK       发送成功
+  * @retval RESULT_FAILE    发送失败
+  */
+  result_t sendData(const uint8_t *data, size_t size);
+
+
+  /*!
+  * @brief checkTransDelay
+  */
+  void checkTransDelay();
+
+  /*!
+  * @brief 关闭数据获取通道 \n
+  */
+  void disableDataGrabbing();
+
+  /*!
+  * @brief 设置串口DTR \n
+  */
+  void setDTR();
+
+  /*!
+  * @brief 清除串口DTR \n
+  */
+  void clearDTR();
+
+  /*!
+   * @brief flushSerial
+   */
+  void flushSerial();
+
+  /*!
+   * @brief checkAutoConnecting
+   */
+  result_t checkAutoConnecting();
+
+  /*!
+   * @brief  换算得出点的距离和角度
+   * @param[in] mdNum 模组序号(0, 1, 2)
+   * @note 使用::updateCalibrationTable生成的标定查找表, 作为::batchTransform 的参考实现
+   */
+  void angTransform(uint8_t mdNum, uint16_t dist, int n, double *dstTheta,
+                    uint16_t *dstDist);
+
+  /*!
+   * @brief 获取模组的批量换算查找表
+   * @param[in] mdNum 模组序号(0, 1, 2)
+   */
+  const GS2TransformTable &moduleTransformTable(uint8_t mdNum) const;
+
+  /*!
+   * @brief 根据模组标定参数(K0/B0/K1/B1/bias)生成每个像素的标定查找表 \n
+   * @param[in] mdNum 模组序号(0, 1, 2)
+   * @note 标定参数更新后必须重新生成
+   */
+  void updateCalibrationTable(uint8_t mdNum);
+
+  /*!
+   * @brief 缓存当前模组当前帧的数据包 \n
+   * 槽位已属于当前帧时更新数据并准备发送, 否则重新占用槽位
+   */
+  void addPointsToVec(GS2Point *nodebuffer, size_t &count);
+
+  /*!
+   * @brief 按模组地址和帧序号直接索引数据包槽位
+   * @param[in] address 模组地址(1, 2, 4)
+   * @param[in] frame   帧序号
+   * @return 地址无效时返回NULL
+   */
+  GS2_Multi_Package *packageSlot(uint8_t address, uint8_t frame);
+
+  /*!
+   * @brief 应用模组返回的标定参数, 参数未变化时不更新查找表
+   * @param[in] address 模组地址(1, 2, 4)
+   * @param[in] info    标定参数
+   * @return 地址无效时返回RESULT_FAIL
+   */
+  result_t applyDevicePara(uint8_t address, const gs_device_para &info);
+
+  /*!
+   * @brief 扫描中发送命令并等待采集线程转交应答, 调用者需持有::_lock \n
+   * 应答保存在::reply_header 和::reply_data
+   * @param[in] command 命令
+   * @param[in] count   等待的应答数, 不大于::PackageMaxModuleNums
+   * @param[in] timeout 超时时间
+   * @return 返回执行结果
+   * @retval RESULT_OK       全部应答已到达
+   * @retval RESULT_TIMEOUT  等待超时
+   * @retval RESULT_FAILE    发送失败
+   */
+  result_t requestReplies(const LidarCommand &command, int count,
+                          uint32_t timeout);
+
+  /*!
+   * @brief 采集线程收到非扫描数据包时, 转交给等待中的命令 \n
+   * 调用时接收缓冲区位于已同步的包头
+   * @param[in] timeout 读取应答数据的超时时间
+   * @return 返回执行结果
+   * @retval RESULT_OK       已转交, 应答已从接收缓冲区移除
+   * @retval RESULT_TIMEOUT  读取应答超时
+   * @retval RESULT_FAILE    不是等待中的应答或校验失败
+   */
+  result_t routeReply(uint32_t timeout);
+
+  /*!
+   * @brief 读取当前端口的缓存标定参数并应用 \n
+   * 成功时缓存参数保存在::calibration_entries
+   * @return 未设置缓存文件, 没有缓存或缓存不完整时返回false
+   */
+  bool loadCalibration();
+
+  /*!
+   * @brief 后台校验缓存线程 \n
+   * 扫描中查询模组标识, 使用缓存启动时再查询标定参数并更新查找表,
+   * 与::calibration_entries 不同时写入缓存
+   */
+  int validateCalibration();
+
+ public:
+  std::atomic<bool>     isConnected;  ///< 串口连接状体
+  std::atomic<bool>     isScanning;   ///< 扫图状态
+  std::atomic<bool>     isAutoReconnect;  ///< 异常自动从新连接
+  std::atomic<bool>     isAutoconnting;  ///< 是否正在自动连接中
+
+
+  enum {
+    DEFAULT_TIMEOUT = 2000,    /**< 默认超时时间. */
+    DEFAULT_HEART_BEAT = 1000, /**< 默认检测掉电功能时间. */
+    MAX_SCAN_NODES = 3600,	   /**< 最大扫描点数. */
+    DEFAULT_TIMEOUT_COUNT = 1,
+    REPLY_MAX_SIZE = 32,       /**< 扫描中转交的应答数据最大长度(含校验和). */
+  };
+
+  ScanQueue      scanQueue;         ///< 数据包队列
+  uint64_t       scan_sequence;     ///< 最近获取的数据包序号
+  int64_t        scan_clock_offset; ///< 最近获取的数据包系统时间与单调时钟之差
+  Locker         _lock;				///< 线程锁
+  Locker         _serial_lock;		///< 串口锁
+  Thread 	     _thread;		   ///< 线程id
+  Thread         _calib_thread;    ///< 后台校验缓存线程
+
+ private:
+  int PackageSampleBytes;            ///< 一个包包含的激光点数
+  serial::Serial *_serial;			///< 串口
+  bool external_serial;             ///< 串口由::setSerial 设置, 重连时不重新创建
+  bool lossless_queue;              ///< 数据包队列满时等待而不丢弃
+  SerialRecorder recorder;          ///< 原始数据录制
+  bool m_intensities;				///< 信号质量状体
+  uint32_t m_baudrate;				///< 波特率
+  bool isSupportMotorDtrCtrl;	    ///< 是否支持电机控制
+  uint32_t trans_delay;				///< 串口传输一个byte时间
+  int m_sampling_rate;              ///< 采样频率
+  int model;                        ///< 雷达型号
+  int sample_rate;                  ///<
+
+
+  float IntervalSampleAngle;
+  float IntervalSampleAngle_LastPackage;
+  uint8_t CheckSum;                ///< 校验和
+  uint8_t scan_frequence;           ///< 协议中雷达转速
+
+  uint8_t CheckSumCal;
+  uint16_t SampleNumlAndCTCal;
+  uint16_t LastSampleAngleCal;
+  bool CheckSumResult;
+  uint16_t Valu8Tou16;
+
+  std::string serial_port;///< 雷达端口
+  uint8_t *globalRecvBuffer; ///< 串口接收缓冲区, 大小::RecvBufferSize
+  size_t  recvHead; ///< 接收缓冲区未处理数据起始位置
+  size_t  recvTail; ///< 接收缓冲区未处理数据结束位置
+  uint64_t recvStamp; ///< 最近一次从串口读取数据的单调时钟时间
+  int64_t  recvClockOffset; ///< 最近一次读取时系统时间与单调时钟之差
+  uint64_t packageStamp; ///< 最近解析的数据包从串口读取完成的单调时钟时间
+  uint64_t packageLastStamp; ///< 最近解析的数据包最后一个点的采集时间的系统时间
+  uint64_t packagePointTime; ///< 最近解析的数据包相邻两点的采样间隔
+  uint8_t  packageIndex; ///< 最近解析的数据包计数, 校验和错误时为0xff
+  bool     packagePolar; ///< 最近解析的数据包已换算角度距离, 否则已换算直角坐标
+  float    packageX[PackageSampleMaxLngth_GS]; ///< 最近解析的数据包模组坐标系x
+  float    packageY[PackageSampleMaxLngth_GS]; ///< 最近解析的数据包模组坐标系y
+  std::atomic<bool> polar_transform; ///< 采集线程换算角度距离, 见::setPolarTransform
+  GS2PackageNode packageSamples[PackageSampleMaxLngth_GS]; ///< 最近解析的数据包原始采样点
+  ClockFilter moduleClock[PackageMaxModuleNums]; ///< 各模组数据包到达时间滤波
+  MetricsRecorder metrics; ///< 运行指标
+  int retryCount;
+  bool has_device_header;
+  uint8_t last_device_byte;
+  int         asyncRecvPos;
+  uint16_t    async_size;
+
+  //singleChannel
+  device_info info_;
+  device_health health_;
+  gs_lidar_ans_header header_;
+  uint8_t  *headerBuffer;
+  uint8_t  *infoBuffer;
+  uint8_t  *healthBuffer;
+  bool     get_device_info_success;
+  bool     get_device_health_success;
+
+  int package_index;
+  uint8_t package_type;
+  bool has_package_error;
+
+  double  d_compensateK0[PackageMaxModuleNums];
+  double  d_compensateK1[PackageMaxModuleNums];
+  double  d_compensateB0[PackageMaxModuleNums];
+  double  d_compensateB1[PackageMaxModuleNums];
+  uint16_t  u_compensateK0[PackageMaxModuleNums];
+  uint16_t  u_compensateK1[PackageMaxModuleNums];
+  uint16_t  u_compensateB0[PackageMaxModuleNums];    
+  uint16_t  u_compensateB1[PackageMaxModuleNums];
+  double  bias[PackageMaxModuleNums];
+  double  calibrationTable[PackageMaxModuleNums][PackageSampleMaxLngth_GS]; ///< 标定查找表
+  GS2TransformTable transformTable[PackageMaxModuleNums]; ///< 批量换算查找表
+  uint8_t   module_mask; ///< 返回了标定参数的模组掩码
+
+  uint8_t   frameNum;  //帧序号
+  uint8_t   moduleNum;  //模块编号
+  bool      isPrepareToSend; //是否准备好发送
+
+  GS2_Multi_Package multi_package[PackageMaxModuleNums][PackageFrameSlotNums]; ///< 数据包槽位
+  GS2_Multi_Package *ready_package; ///< 准备发送的数据包
+
+  Locker    table_lock;     ///< 保护标定查找表, 采集线程更新时与消费者线程的换算互斥
+  Locker    reply_lock;     ///< 保护以下扫描中的命令应答
+  Event     reply_event;    ///< 等待的应答全部到达时触发
+  uint8_t   reply_type;     ///< 扫描中等待的应答类型, 0为无
+  int       reply_expected; ///< 等待的应答数
+  int       reply_count;    ///< 已收到的应答数
+  gs_lidar_ans_header reply_header[PackageMaxModuleNums]; ///< 应答包头
+  uint8_t   reply_data[PackageMaxModuleNums][REPLY_MAX_SIZE]; ///< 应答数据, 含校验和
+
+  std::string calibration_cache; ///< 标定参数缓存文件
+  std::vector<CalibrationEntry> calibration_entries; ///< 本次启动使用的标定参数
+  bool calibration_cached; ///< ::calibration_entries 来自缓存文件
+
+};
+
+}// namespace ydlidar
+
+#endif // YDLIDAR_DRIVER_H
@@ -0,0 +1,102 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+
+namespace ydlidar {
+
+/// 日志级别
+typedef enum {
+  LOG_LEVEL_DEBUG = 0,  ///< 调试信息, 如每个数据包的解析结果
+  LOG_LEVEL_INFO,       ///< 一般信息
+  LOG_LEVEL_WARN,       ///< 可恢复的异常, 如超时
+  LOG_LEVEL_ERROR,      ///< 错误
+  LOG_LEVEL_OFF,        ///< 关闭日志
+} LogLevel;
+
+/*!
+* 异步分级日志 \n
+* 日志格式化后放入无锁队列, 由后台线程写入stdout(DEBUG/INFO)或stderr(WARN/ERROR),
+* 调用线程不会阻塞在控制台输出上; 队列满时丢弃并计数
+* @note 使用::YDLIDAR_LOG 和::YDLIDAR_LOG_EVERY, 低于当前级别的日志不格式化
+*/
+class Logger {
+ public:
+  /*!
+  * @brief 设置日志级别, 默认::LOG_LEVEL_INFO
+  */
+  static void setLevel(int level) {
+    s_level.store(level, std::memory_order_relaxed);
+  }
+
+  static int level() {
+    return s_level.load(std::memory_order_relaxed);
+  }
+
+  static bool enabled(int level) {
+    return level >= s_level.load(std::memory_order_relaxed);
+  }
+
+  /*!
+  * @brief 格式化并放入日志队列
+  */
+  static void log(int level, const char *fmt, ...)
+  __attribute__((format(printf, 2, 3)));
+
+  /*!
+  * @brief 等待队列中的日志写完
+  */
+  static void flush();
+
+  /*!
+  * @brief 队列满时丢弃的日志数
+  */
+  static uint64_t dropped();
+
+ private:
+  static std::atomic<int> s_level;
+};
+
+/*!
+* 日志限速, 每个调用位置一个 \n
+* 间隔内只输出第一条, 其余计数并在下一条输出时报告
+*/
+class LogRateLimiter {
+ public:
+  LogRateLimiter() : _last(0), _suppressed(0) {}
+
+  /*!
+  * @param[in]  interval   最小间隔[ms]
+  * @param[out] suppressed 上次输出后被抑制的日志数
+  * @return 允许输出时返回true
+  */
+  bool allow(uint32_t interval, uint32_t &suppressed);
+
+ private:
+  std::atomic<uint64_t> _last;
+  std::atomic<uint32_t> _suppressed;
+};
+
+}// namespace ydlidar
+
+/// 输出日志, 低于当前级别时不计算参数
+#define YDLIDAR_LOG(level, ...) \
+  do { \
+    if (ydlidar::Logger::enabled(level)) { \
+      ydlidar::Logger::log(level, __VA_ARGS__); \
+    } \
+  } while (0)
+
+/// 输出日志, 每个调用位置每interval毫秒最多一条, 用于数据包解析等高频路径
+#define YDLIDAR_LOG_EVERY(level, interval, ...) \
+  do { \
+    static ydlidar::LogRateLimiter ydlidar_log_limiter_; \
+    uint32_t ydlidar_log_suppressed_ = 0; \
+    if (ydlidar::Logger::enabled(level) && \
+        ydlidar_log_limiter_.allow(interval, ydlidar_log_suppressed_)) { \
+      ydlidar::Logger::log(level, __VA_ARGS__); \
+      if (ydlidar_log_suppressed_) { \
+        ydlidar::Logger::log(level, "(%u similar messages suppressed)", \
+                             ydlidar_log_suppressed_); \
+      } \
+    } \
+  } while (0)
@@ -1,362 +1,521 @@
-﻿/*********************************************************************
-* Software License Agreement (BSD License)
-*
-*  Copyright (c) 2018, EAIBOT, Inc.
-*  All rights reserved.
-*
-*  Redistribution and use in source and binary forms, with or without
-*  modification, are permitted provided that the following conditions
-*  are met:
-*
-*   * Redistributions of source code must retain the above copyright
-*     notice, this list of conditions and the following disclaimer.
-*   * Redistributions in binary form must reproduce the above
-*     copyright notice, this list of conditions and the following
-*     disclaimer in the documentation and/or other materials provided
-*     with the distribution.
-*   * Neither the name of the Willow Garage nor the names of its
-*     contributors may be used to endorse or promote products derived
-*     from this software without specific prior written permission.
-*
-*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
-*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
-*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
-*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
-*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
-*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
-*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
-*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
-*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
-*  POSSIBILITY OF SUCH DAMAGE.
-*********************************************************************/
-#pragma once
-#include "v8stdint.h"
-#include <vector>
-
-#define PropertyBuilderByName(type, name, access_permission)\
-    access_permission:\
-        type m_##name;\
-    public:\
-    inline void set##name(type v) {\
-        m_##name = v;\
-    }\
-    inline type get##name() {\
-        return m_##name;\
-}\
-
-
-#if !defined(_countof)
-#define _countof(_Array) (int)(sizeof(_Array) / sizeof(_Array[0]))
-#endif
-
-#ifndef M_PI
-#define M_PI 3.1415926
-#endif
-
-#define SUNNOISEINTENSITY 0xff
-#define GLASSNOISEINTENSITY 0xfe
-
-#define LIDAR_CMD_STOP                      0x65
-#define LIDAR_CMD_SCAN                      0x60
-#define LIDAR_CMD_FORCE_SCAN                0x61
-#define LIDAR_CMD_RESET                     0x80
-#define LIDAR_CMD_FORCE_STOP                0x00
-#define LIDAR_CMD_GET_EAI                   0x55
-#define LIDAR_CMD_GET_DEVICE_INFO           0x90
-#define LIDAR_CMD_GET_DEVICE_HEALTH         0x92
-#define LIDAR_ANS_TYPE_DEVINFO              0x4
-#define LIDAR_ANS_TYPE_DEVHEALTH            0x6
-#define LIDAR_CMD_SYNC_BYTE                 0xA5
-#define LIDAR_CMDFLAG_HAS_PAYLOAD           0x80
-#define LIDAR_ANS_SYNC_BYTE1                0xA5
-#define LIDAR_ANS_SYNC_BYTE2                0x5A
-#define LIDAR_ANS_TYPE_MEASUREMENT          0x81
-#define LIDAR_RESP_MEASUREMENT_SYNCBIT        (0x1<<0)
-#define LIDAR_RESP_MEASUREMENT_QUALITY_SHIFT  2
-#define LIDAR_RESP_MEASUREMENT_CHECKBIT       (0x1<<0)
-#define LIDAR_RESP_MEASUREMENT_ANGLE_SHIFT    1
-#define LIDAR_RESP_MEASUREMENT_DISTANCE_SHIFT  2
-#define LIDAR_RESP_MEASUREMENT_ANGLE_SAMPLE_SHIFT 8
-
-#define LIDAR_CMD_RUN_POSITIVE             0x06
-#define LIDAR_CMD_RUN_INVERSION            0x07
-#define LIDAR_CMD_SET_AIMSPEED_ADDMIC      0x09
-#define LIDAR_CMD_SET_AIMSPEED_DISMIC      0x0A
-#define LIDAR_CMD_SET_AIMSPEED_ADD         0x0B
-#define LIDAR_CMD_SET_AIMSPEED_DIS         0x0C
-#define LIDAR_CMD_GET_AIMSPEED             0x0D
-
-#define LIDAR_CMD_SET_SAMPLING_RATE        0xD0
-#define LIDAR_CMD_GET_SAMPLING_RATE        0xD1
-#define LIDAR_STATUS_OK                    0x0
-#define LIDAR_STATUS_WARNING               0x1
-#define LIDAR_STATUS_ERROR                 0x2
-
-#define LIDAR_CMD_ENABLE_LOW_POWER         0x01
-#define LIDAR_CMD_DISABLE_LOW_POWER        0x02
-#define LIDAR_CMD_STATE_MODEL_MOTOR        0x05
-#define LIDAR_CMD_ENABLE_CONST_FREQ        0x0E
-#define LIDAR_CMD_DISABLE_CONST_FREQ       0x0F
-
-#define LIDAR_CMD_GET_OFFSET_ANGLE          0x93
-#define LIDAR_CMD_SAVE_SET_EXPOSURE         0x94
-#define LIDAR_CMD_SET_LOW_EXPOSURE          0x95
-#define LIDAR_CMD_ADD_EXPOSURE       	    0x96
-#define LIDAR_CMD_DIS_EXPOSURE       	    0x97
-
-#define Angle_Px   1.22
-#define Angle_Py   5.315
-#define Angle_PAngle   22.5
-
-//gs2
-#define GS_LIDAR_CMD_GET_ADDRESS               0x60
-#define GS_LIDAR_CMD_GET_PARAMETER             0x61
-#define GS_LIDAR_CMD_GET_VERSION               0x62
-#define GS_LIDAR_CMD_SCAN                      0x63
-#define GS_LIDAR_ANS_SCAN                      0x63
-#define GS_LIDAR_CMD_STOP                      0x64
-#define GS_LIDAR_CMD_RESET                     0x67
-#define GS_LIDAR_CMD_SET_BIAS                  0xD9
-#define GS_LIDAR_CMD_SET_DEBUG_MODE            0xF0
-
-#define PackageMaxModuleNums  0x03
-#define PackageSampleMaxLngth_GS 0xA0  //160*2
-
-
-#define MaximumNumberOfPackages  765
-#define PackageSampleMaxLngth 0x100
-typedef enum {
-  CT_Normal = 0,
-  CT_RingStart  = 1,
-  CT_Tail,
-} CT;
-#define Node_Default_Quality (10)
-#define Node_Sync 1
-#define Node_NotSync 2
-#define PackagePaidBytes 10
-#define PackagePaidBytes_GS 8
-#define PH 0x55AA
-#define NORMAL_PACKAGE_SIZE 331
-
-
-typedef enum {
-  TYPE_TOF = 0,
-  TYPE_TRIANGLE  = 1,
-  TYPE_Tail,
-} LidarTypeID;
-
-#if defined(_WIN32)
-#pragma pack(1)
-#endif
-
-struct node_info {
-  uint8_t    sync_flag;  //sync flag
-  uint16_t   sync_quality;//!信号质量
-  uint16_t   angle_q6_checkbit; //!测距点角度
-  uint16_t   distance_q2; //! 当前测距点距离
-  uint64_t   stamp; //! 时间戳
-  uint8_t    scan_frequence;//! 特定版本此值才有效,无效值是0
-  uint8_t    debug_info[12];
-  uint8_t    index;
-} __attribute__((packed)) ;
-
-struct GS2_Multi_Package {
-    int frameNum;
-    int moduleNum;
-    bool left = false;
-    bool right = false;
-    node_info  all_points[160];
-} __attribute__((packed)) ;
-
-struct GS2PackageNode {
-  uint16_t PakageSampleDistance:9;
-  uint16_t PakageSampleQuality:7;
-} __attribute__((packed));
-
-struct gs2_node_package {
-  uint32_t  package_Head;
-  uint8_t   address;
-  uint8_t   package_CT;
-  uint16_t  size;
-  uint16_t  BackgroudLight;
-  GS2PackageNode  packageSample[PackageSampleMaxLngth_GS];
-  uint8_t  checkSum;
-} __attribute__((packed)) ;
-
-struct gs_lidar_ans_header {
-    uint8_t  syncByte0;
-    uint8_t  syncByte1;
-    uint8_t  syncByte2;
-    uint8_t  syncByte3;
-    uint8_t  address;
-    uint8_t  type;
-    uint16_t size;
-} __attribute__((packed));
-
-struct gs_device_para {
-    uint16_t u_compensateK0;
-    uint16_t u_compensateB0;
-    uint16_t u_compensateK1;
-    uint16_t u_compensateB1;
-    int8_t  bias;
-    uint8_t  crc;
-} __attribute__((packed)) ;
-
-struct cmd_packet_gs {
-    uint8_t syncByte0;
-    uint8_t syncByte1;
-    uint8_t syncByte2;
-    uint8_t syncByte3;
-    uint8_t address;
-    uint8_t cmd_flag;
-    uint16_t size;
-} __attribute__((packed)) ;
-
-struct device_info {
-  uint8_t   model; ///< 雷达型号
-  uint16_t  firmware_version; ///< 固件版本号
-  uint8_t   hardware_version; ///< 硬件版本号
-  uint8_t   serialnum[16];    ///< 系列号
-} __attribute__((packed)) ;
-
-struct device_health {
-  uint8_t   status; ///< 健康状体
-  uint16_t  error_code; ///< 错误代码
-} __attribute__((packed))  ;
-
-struct sampling_rate {
-  uint8_t rate;	///< 采样频率
-} __attribute__((packed))  ;
-
-struct scan_frequency {
-  uint32_t frequency;	///< 扫描频率
-} __attribute__((packed))  ;
-
-struct scan_rotation {
-  uint8_t rotation;
-} __attribute__((packed))  ;
-
-struct scan_exposure {
-  uint8_t exposure;	///< 低光功率模式
-} __attribute__((packed))  ;
-
-struct scan_heart_beat {
-  uint8_t enable;	///< 掉电保护状态
-} __attribute__((packed));
-
-struct scan_points {
-  uint8_t flag;
-} __attribute__((packed))  ;
-
-struct function_state {
-  uint8_t state;
-} __attribute__((packed))  ;
-
-struct offset_angle {
-  int32_t angle;
-} __attribute__((packed))  ;
-
-struct cmd_packet {
-  uint8_t syncByte;
-  uint8_t cmd_flag;
-  uint8_t size;
-  uint8_t data;
-} __attribute__((packed)) ;
-
-
-#if defined(_WIN32)
-#pragma pack()
-#endif
-
-struct LaserPoint {
-  //! lidar angle　[rad]
-  float angle;
-  //! lidar range [m]
-  float range;
-  //! lidar intensity
-  float intensity;
-  LaserPoint &operator = (const LaserPoint &data) {
-    this->angle = data.angle;
-    this->range = data.range;
-    this->intensity = data.intensity;
-    return *this;
-  }
-}__attribute__((packed));
-
-struct LaserDebug {
-  uint8_t     W3F4CusMajor_W4F0CusMinor;
-  uint8_t     W4F3Model_W3F0DebugInfTranVer;
-  uint8_t     W3F4HardwareVer_W4F0FirewareMajor;
-  uint8_t     W3F4BoradHardVer_W4F0Moth;
-  uint8_t     W2F5Output2K4K5K_W5F0Date;
-  uint8_t     W1F6GNoise_W1F5SNoise_W1F4MotorCtl_W4F0SnYear;
-  uint8_t     W7F0SnNumH;
-  uint8_t     W7F0SnNumL;
-  uint8_t     MaxDebugIndex;
-};
-
-//! A struct for returning configuration from the YDLIDAR
-struct LaserConfig {
-  //! Start angle for the laser scan [rad].  0 is forward and angles are measured clockwise when viewing YDLIDAR from the top.
-  float min_angle;
-  //! Stop angle for the laser scan [rad].   0 is forward and angles are measured clockwise when viewing YDLIDAR from the top.
-  float max_angle;
-  //! angle resoltuion [rad]
-  float angle_increment;
-  //! Scan resoltuion [s]
-  float time_increment;
-  //! Time between scans
-  float scan_time;
-  //! Minimum range [m]
-  float min_range;
-  //! Maximum range [m]
-  float max_range;
-  LaserConfig &operator = (const LaserConfig &data) {
-    min_angle = data.min_angle;
-    max_angle = data.max_angle;
-    angle_increment = data.angle_increment;
-    time_increment = data.time_increment;
-    scan_time = data.scan_time;
-    min_range = data.min_range;
-    max_range = data.max_range;
-    return *this;
-  }
-};
-
-
-//struct LaserScan {
-//  //! Array of ranges
-//  std::vector<float> ranges;
-//  //! Array of intensities
-//  std::vector<float> intensities;
-//  //! System time when first range was measured in nanoseconds
-//  uint64_t system_time_stamp;
-//  //! Configuration of scan
-//  LaserConfig config;
-//  LaserScan &operator = (const LaserScan &data) {
-//    this->ranges = data.ranges;
-//    this->intensities = data.intensities;
-//    system_time_stamp = data.system_time_stamp;
-//    config = data.config;
-//    return *this;
-//  }
-//};
-
-struct LaserScan {
-  //! System time when first range was measured in nanoseconds
-  uint64_t stamp;
-  //! Array of lidar points
-  std::vector<LaserPoint> points;
-  //! Configuration of scan
-  LaserConfig config;
-  LaserScan &operator = (const LaserScan &data) {
-    this->points = data.points;
-    this->stamp = data.stamp;
-    this->config = data.config;
-    return *this;
-  }
-  int  moduleNum;
-
-}__attribute__((packed));
+﻿/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+#pragma once
+#include "v8stdint.h"
+#include <vector>
+#include <string.h>
+#include <utility>
+
+#define PropertyBuilderByName(type, name, access_permission)\
+    access_permission:\
+        type m_##name;\
+    public:\
+    inline void set##name(type v) {\
+        m_##name = v;\
+    }\
+    inline type get##name() {\
+        return m_##name;\
+}\
+
+
+#if !defined(_countof)
+#define _countof(_Array) (int)(sizeof(_Array) / sizeof(_Array[0]))
+#endif
+
+#ifndef M_PI
+#define M_PI 3.1415926
+#endif
+
+#define SUNNOISEINTENSITY 0xff
+#define GLASSNOISEINTENSITY 0xfe
+
+#define LIDAR_CMD_STOP                      0x65
+#define LIDAR_CMD_SCAN                      0x60
+#define LIDAR_CMD_FORCE_SCAN                0x61
+#define LIDAR_CMD_RESET                     0x80
+#define LIDAR_CMD_FORCE_STOP                0x00
+#define LIDAR_CMD_GET_EAI                   0x55
+#define LIDAR_CMD_GET_DEVICE_INFO           0x90
+#define LIDAR_CMD_GET_DEVICE_HEALTH         0x92
+#define LIDAR_ANS_TYPE_DEVINFO              0x4
+#define LIDAR_ANS_TYPE_DEVHEALTH            0x6
+#define LIDAR_CMD_SYNC_BYTE                 0xA5
+#define LIDAR_CMDFLAG_HAS_PAYLOAD           0x80
+#define LIDAR_ANS_SYNC_BYTE1                0xA5
+#define LIDAR_ANS_SYNC_BYTE2                0x5A
+#define LIDAR_ANS_TYPE_MEASUREMENT          0x81
+#define LIDAR_RESP_MEASUREMENT_SYNCBIT        (0x1<<0)
+#define LIDAR_RESP_MEASUREMENT_QUALITY_SHIFT  2
+#define LIDAR_RESP_MEASUREMENT_CHECKBIT       (0x1<<0)
+#define LIDAR_RESP_MEASUREMENT_ANGLE_SHIFT    1
+#define LIDAR_RESP_MEASUREMENT_DISTANCE_SHIFT  2
+#define LIDAR_RESP_MEASUREMENT_ANGLE_SAMPLE_SHIFT 8
+
+#define LIDAR_CMD_RUN_POSITIVE             0x06
+#define LIDAR_CMD_RUN_INVERSION            0x07
+#define LIDAR_CMD_SET_AIMSPEED_ADDMIC      0x09
+#define LIDAR_CMD_SET_AIMSPEED_DISMIC      0x0A
+#define LIDAR_CMD_SET_AIMSPEED_ADD         0x0B
+#define LIDAR_CMD_SET_AIMSPEED_DIS         0x0C
+#define LIDAR_CMD_GET_AIMSPEED             0x0D
+
+#define LIDAR_CMD_SET_SAMPLING_RATE        0xD0
+#define LIDAR_CMD_GET_SAMPLING_RATE        0xD1
+#define LIDAR_STATUS_OK                    0x0
+#define LIDAR_STATUS_WARNING               0x1
+#define LIDAR_STATUS_ERROR                 0x2
+
+#define LIDAR_CMD_ENABLE_LOW_POWER         0x01
+#define LIDAR_CMD_DISABLE_LOW_POWER        0x02
+#define LIDAR_CMD_STATE_MODEL_MOTOR        0x05
+#define LIDAR_CMD_ENABLE_CONST_FREQ        0x0E
+#define LIDAR_CMD_DISABLE_CONST_FREQ       0x0F
+
+#define LIDAR_CMD_GET_OFFSET_ANGLE          0x93
+#define LIDAR_CMD_SAVE_SET_EXPOSURE         0x94
+#define LIDAR_CMD_SET_LOW_EXPOSURE          0x95
+#define LIDAR_CMD_ADD_EXPOSURE       	    0x96
+#define LIDAR_CMD_DIS_EXPOSURE       	    0x97
+
+#define Angle_Px   1.22
+#define Angle_Py   5.315
+#define Angle_PAngle   22.5
+
+//gs2
+#define GS_LIDAR_CMD_GET_ADDRESS               0x60
+#define GS_LIDAR_CMD_GET_PARAMETER             0x61
+#define GS_LIDAR_CMD_GET_VERSION               0x62
+#define GS_LIDAR_CMD_SCAN                      0x63
+#define GS_LIDAR_ANS_SCAN                      0x63
+#define GS_LIDAR_CMD_STOP                      0x64
+#define GS_LIDAR_CMD_RESET                     0x67
+#define GS_LIDAR_CMD_SET_BIAS                  0xD9
+#define GS_LIDAR_CMD_SET_DEBUG_MODE            0xF0
+
+#define PackageMaxModuleNums  0x03
+#define PackageSampleMaxLngth_GS 0xA0  //160*2
+
+
+#define MaximumNumberOfPackages  765
+#define PackageFrameSlotNums  4   ///< 每个模组缓存的帧数, 必须为2的幂
+#define PackageSampleMaxLngth 0x100
+typedef enum {
+  CT_Normal = 0,
+  CT_RingStart  = 1,
+  CT_Tail,
+} CT;
+#define Node_Default_Quality (10)
+#define Node_Sync 1
+#define Node_NotSync 2
+#define PackagePaidBytes 10
+#define PackagePaidBytes_GS 8
+#define PH 0x55AA
+#define NORMAL_PACKAGE_SIZE 331
+#define RecvBufferSize (16 * NORMAL_PACKAGE_SIZE) ///< 串口接收缓冲区大小
+
+
+typedef enum {
+  TYPE_TOF = 0,
+  TYPE_TRIANGLE  = 1,
+  TYPE_Tail,
+} LidarTypeID;
+
+/// 多模组合并帧缺少模组数据包时的处理方式
+typedef enum {
+  MERGE_WAIT = 0,   ///< 模组重复时保留最新数据包, 等到超时后输出不完整帧
+  MERGE_PARTIAL,    ///< 模组重复或超时时立即输出不完整帧
+  MERGE_DROP,       ///< 模组重复或超时时丢弃不完整帧
+  MERGE_Tail,
+} MergePolicy;
+
+/// 合并帧的::LaserScan::moduleNum
+#define MergedModuleNum (-1)
+
+#if defined(_WIN32)
+#pragma pack(1)
+#endif
+
+struct node_info {
+  uint8_t    sync_flag;  //sync flag
+  uint16_t   sync_quality;//!信号质量
+  uint16_t   angle_q6_checkbit; //!测距点角度
+  uint16_t   distance_q2; //! 当前测距点距离
+  uint64_t   stamp; //! 采集时间的系统时间[ns]
+  uint8_t    scan_frequence;//! 特定版本此值才有效,无效值是0
+  uint8_t    debug_info[12];
+  uint8_t    index;
+} __attribute__((packed)) ;
+
+/*!
+* GS2驱动内部激光点, 8字节自然对齐 \n
+* 采集时间、模组序号等按数据包存放(见::ModuleFrame), ::node_info 只在兼容接口中使用
+*/
+struct GS2Point {
+  uint16_t   angle_q6_checkbit; //!测距点角度, 同::node_info
+  uint16_t   distance_q2; //! 当前测距点距离
+  uint16_t   quality; //!信号质量
+  uint8_t    sync_flag; //sync flag
+  uint8_t    reserved;
+};
+
+struct GS2PackageNode {
+  uint16_t PakageSampleDistance:9;
+  uint16_t PakageSampleQuality:7;
+} __attribute__((packed));
+
+struct GS2_Multi_Package {
+    int frameNum;
+    int moduleNum;
+    bool left = false;
+    bool right = false;
+    uint64_t   last_stamp; ///< 最后一个点的采集时间[ns]
+    uint64_t   point_time; ///< 相邻两点的采样间隔[ns]
+    uint8_t    index; ///< 数据包计数, 校验和错误时为0xff
+    bool       polar; ///< all_points已换算角度距离, 否则x, y已换算直角坐标
+    GS2Point   all_points[160];
+    GS2PackageNode samples[160]; ///< 原始采样点, 用于换算直角坐标
+    float      x[160]; ///< 模组坐标系x
+    float      y[160]; ///< 模组坐标系y
+};
+
+struct gs2_node_package {
+  uint32_t  package_Head;
+  uint8_t   address;
+  uint8_t   package_CT;
+  uint16_t  size;
+  uint16_t  BackgroudLight;
+  GS2PackageNode  packageSample[PackageSampleMaxLngth_GS];
+  uint8_t  checkSum;
+} __attribute__((packed)) ;
+
+struct gs_lidar_ans_header {
+    uint8_t  syncByte0;
+    uint8_t  syncByte1;
+    uint8_t  syncByte2;
+    uint8_t  syncByte3;
+    uint8_t  address;
+    uint8_t  type;
+    uint16_t size;
+} __attribute__((packed));
+
+struct gs_device_para {
+    uint16_t u_compensateK0;
+    uint16_t u_compensateB0;
+    uint16_t u_compensateK1;
+    uint16_t u_compensateB1;
+    int8_t  bias;
+    uint8_t  crc;
+} __attribute__((packed)) ;
+
+struct cmd_packet_gs {
+    uint8_t syncByte0;
+    uint8_t syncByte1;
+    uint8_t syncByte2;
+    uint8_t syncByte3;
+    uint8_t address;
+    uint8_t cmd_flag;
+    uint16_t size;
+} __attribute__((packed)) ;
+
+/// 待发送的命令, 发送时组帧为 cmd_packet_gs + payload + 校验和
+struct LidarCommand {
+    uint8_t     address;  ///< 模组地址, 0x00为广播
+    uint8_t     cmd_flag; ///< 命令码
+    const void *payload;  ///< 命令参数, 可为NULL
+    size_t      size;     ///< 命令参数长度
+};
+
+struct device_info {
+  uint8_t   model; ///< 雷达型号
+  uint16_t  firmware_version; ///< 固件版本号
+  uint8_t   hardware_version; ///< 硬件版本号
+  uint8_t   serialnum[16];    ///< 系列号
+} __attribute__((packed)) ;
+
+struct device_health {
+  uint8_t   status; ///< 健康状体
+  uint16_t  error_code; ///< 错误代码
+} __attribute__((packed))  ;
+
+struct sampling_rate {
+  uint8_t rate;	///< 采样频率
+} __attribute__((packed))  ;
+
+struct scan_frequency {
+  uint32_t frequency;	///< 扫描频率
+} __attribute__((packed))  ;
+
+struct scan_rotation {
+  uint8_t rotation;
+} __attribute__((packed))  ;
+
+struct scan_exposure {
+  uint8_t exposure;	///< 低光功率模式
+} __attribute__((packed))  ;
+
+struct scan_heart_beat {
+  uint8_t enable;	///< 掉电保护状态
+} __attribute__((packed));
+
+struct scan_points {
+  uint8_t flag;
+} __attribute__((packed))  ;
+
+struct function_state {
+  uint8_t state;
+} __attribute__((packed))  ;
+
+struct offset_angle {
+  int32_t angle;
+} __attribute__((packed))  ;
+
+struct cmd_packet {
+  uint8_t syncByte;
+  uint8_t cmd_flag;
+  uint8_t size;
+  uint8_t data;
+} __attribute__((packed)) ;
+
+
+#if defined(_WIN32)
+#pragma pack()
+#endif
+
+struct LaserPoint {
+  //! lidar angle　[rad]
+  float angle;
+  //! lidar range [m]
+  float range;
+  //! lidar intensity
+  float intensity;
+  LaserPoint &operator = (const LaserPoint &data) {
+    this->angle = data.angle;
+    this->range = data.range;
+    this->intensity = data.intensity;
+    return *this;
+  }
+}__attribute__((packed));
+
+struct LaserDebug {
+  uint8_t     W3F4CusMajor_W4F0CusMinor;
+  uint8_t     W4F3Model_W3F0DebugInfTranVer;
+  uint8_t     W3F4HardwareVer_W4F0FirewareMajor;
+  uint8_t     W3F4BoradHardVer_W4F0Moth;
+  uint8_t     W2F5Output2K4K5K_W5F0Date;
+  uint8_t     W1F6GNoise_W1F5SNoise_W1F4MotorCtl_W4F0SnYear;
+  uint8_t     W7F0SnNumH;
+  uint8_t     W7F0SnNumL;
+  uint8_t     MaxDebugIndex;
+};
+
+//! A struct for returning configuration from the YDLIDAR
+struct LaserConfig {
+  //! Start angle for the laser scan [rad].  0 is forward and angles are measured clockwise when viewing YDLIDAR from the top.
+  float min_angle;
+  //! Stop angle for the laser scan [rad].   0 is forward and angles are measured clockwise when viewing YDLIDAR from the top.
+  float max_angle;
+  //! angle resoltuion [rad]
+  float angle_increment;
+  //! Scan resoltuion [s]
+  float time_increment;
+  //! Time between scans
+  float scan_time;
+  //! Minimum range [m]
+  float min_range;
+  //! Maximum range [m]
+  float max_range;
+  LaserConfig &operator = (const LaserConfig &data) {
+    min_angle = data.min_angle;
+    max_angle = data.max_angle;
+    angle_increment = data.angle_increment;
+    time_increment = data.time_increment;
+    scan_time = data.scan_time;
+    min_range = data.min_range;
+    max_range = data.max_range;
+    return *this;
+  }
+};
+
+
+//struct LaserScan {
+//  //! Array of ranges
+//  std::vector<float> ranges;
+//  //! Array of intensities
+//  std::vector<float> intensities;
+//  //! System time when first range was measured in nanoseconds
+//  uint64_t system_time_stamp;
+//  //! Configuration of scan
+//  LaserConfig config;
+//  LaserScan &operator = (const LaserScan &data) {
+//    this->ranges = data.ranges;
+//    this->intensities = data.intensities;
+//    system_time_stamp = data.system_time_stamp;
+//    config = data.config;
+//    return *this;
+//  }
+//};
+
+struct LaserScan {
+  //! System time when first range was measured in nanoseconds
+  uint64_t stamp;
+  //! stamp对应的单调时钟时间[ns], 不受系统时间调整影响
+  uint64_t monotonicStamp;
+  //! Array of lidar points
+  std::vector<LaserPoint> points;
+  //! 各点采集时间相对stamp的偏移[s], 与points一一对应
+  std::vector<float> timeOffsets;
+  //! Configuration of scan
+  LaserConfig config;
+  LaserScan() : stamp(0), monotonicStamp(0), moduleNum(0) {
+    memset(moduleStamps, 0, sizeof(moduleStamps));
+  }
+  LaserScan(const LaserScan &data) : stamp(data.stamp),
+    monotonicStamp(data.monotonicStamp), points(data.points),
+    timeOffsets(data.timeOffsets), config(data.config),
+    moduleNum(data.moduleNum) {
+    memcpy(moduleStamps, data.moduleStamps, sizeof(moduleStamps));
+  }
+  //! 转移points, 不复制
+  LaserScan(LaserScan &&data) noexcept : stamp(data.stamp),
+    monotonicStamp(data.monotonicStamp), points(std::move(data.points)),
+    timeOffsets(std::move(data.timeOffsets)), config(data.config),
+    moduleNum(data.moduleNum) {
+    memcpy(moduleStamps, data.moduleStamps, sizeof(moduleStamps));
+  }
+  //! 转移points, 不复制
+  LaserScan &operator = (LaserScan &&data) noexcept {
+    this->points = std::move(data.points);
+    this->timeOffsets = std::move(data.timeOffsets);
+    this->stamp = data.stamp;
+    this->monotonicStamp = data.monotonicStamp;
+    this->config = data.config;
+    this->moduleNum = data.moduleNum;
+    memcpy(this->moduleStamps, data.moduleStamps, sizeof(moduleStamps));
+    return *this;
+  }
+  LaserScan &operator = (const LaserScan &data) {
+    this->points = data.points;
+    this->timeOffsets = data.timeOffsets;
+    this->stamp = data.stamp;
+    this->monotonicStamp = data.monotonicStamp;
+    this->config = data.config;
+    this->moduleNum = data.moduleNum;
+    memcpy(this->moduleStamps, data.moduleStamps, sizeof(moduleStamps));
+    return *this;
+  }
+  //! 模组序号(0, 1, 2), 合并帧为::MergedModuleNum
+  int  moduleNum;
+  //! 合并帧中各模组数据包的系统时间[ns], 缺少的模组为0
+  uint64_t moduleStamps[PackageMaxModuleNums];
+
+};
+
+/*!
+* 按数组(Structure of Arrays)存放的激光扫描数据 \n
+* ::clear 保留容量, 重复使用同一对象时稳定状态下不分配内存
+*/
+struct LaserScanArrays {
+  //! System time when first range was measured in nanoseconds
+  uint64_t stamp;
+  //! stamp对应的单调时钟时间[ns]
+  uint64_t monotonicStamp;
+  //! Array of lidar angles [rad]
+  std::vector<float> angles;
+  //! Array of lidar ranges [m]
+  std::vector<float> ranges;
+  //! Array of lidar intensities
+  std::vector<float> intensities;
+  //! 各点采集时间相对stamp的偏移[s]
+  std::vector<float> timeOffsets;
+  //! Configuration of scan
+  LaserConfig config;
+  //! 模组序号(0, 1, 2)
+  int  moduleNum;
+
+  LaserScanArrays() : stamp(0), monotonicStamp(0), moduleNum(0) {}
+  size_t size() const {
+    return ranges.size();
+  }
+  void reserve(size_t size) {
+    angles.reserve(size);
+    ranges.reserve(size);
+    intensities.reserve(size);
+    timeOffsets.reserve(size);
+  }
+  void resize(size_t size) {
+    angles.resize(size);
+    ranges.resize(size);
+    intensities.resize(size);
+    timeOffsets.resize(size);
+  }
+  void clear() {
+    angles.clear();
+    ranges.clear();
+    intensities.clear();
+    timeOffsets.clear();
+  }
+  void push_back(float angle, float range, float intensity, float timeOffset) {
+    angles.push_back(angle);
+    ranges.push_back(range);
+    intensities.push_back(intensity);
+    timeOffsets.push_back(timeOffset);
+  }
+};
+
+//! 直角坐标激光点, 雷达坐标系: 0度为+x, 角度增大方向为+y
+struct LaserCartesianPoint {
+  //! 与距离单位相同, 无效点为0
+  float x;
+  float y;
+  //! lidar intensity
+  float intensity;
+};
+
+//! 直角坐标激光数据, 不经过角度距离换算
+struct LaserScanCartesian {
+  //! System time when first range was measured in nanoseconds
+  uint64_t stamp;
+  //! stamp对应的单调时钟时间[ns]
+  uint64_t monotonicStamp;
+  //! Array of lidar points
+  std::vector<LaserCartesianPoint> points;
+  //! 各点采集时间相对stamp的偏移[s]
+  std::vector<float> timeOffsets;
+  //! Configuration of scan
+  LaserConfig config;
+  //! 模组序号(0, 1, 2)
+  int  moduleNum;
+
+  LaserScanCartesian() : stamp(0), monotonicStamp(0), moduleNum(0) {}
+};
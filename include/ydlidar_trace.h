@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+#include <string>
+
+namespace ydlidar {
+
+/// 跟踪的流水线阶段
+typedef enum {
+  TRACE_SERIAL_WAIT = 0,  ///< 等待串口数据(waitfordata)
+  TRACE_SERIAL_READ,      ///< 读取串口数据
+  TRACE_HEADER_SYNC,      ///< 同步包头
+  TRACE_CHECKSUM,         ///< 校验和
+  TRACE_TRANSFORM,        ///< 角度距离换算
+  TRACE_ADD_POINTS,       ///< addPointsToVec
+  TRACE_HANDOFF,          ///< 数据包放入队列
+  TRACE_PROCESS,          ///< CYdLidar::doProcessSimple/doProcessMerged
+  TRACE_STAGE_NUMS,
+} TraceStage;
+
+/*!
+* 流水线阶段跟踪 \n
+* 开启后每个线程把各阶段的开始/结束时间写入各自的环形缓冲区,
+* 可导出为Chrome trace-event JSON(chrome://tracing 或 Perfetto打开)
+* @note 关闭时::YDLIDAR_TRACE_SCOPE 只有一次可预测的分支
+*/
+class Tracer {
+ public:
+  enum {
+    BufferSize = 16384,  ///< 每个线程保留的最近事件数, 必须为2的幂
+  };
+
+  static bool enabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+
+  /*!
+  * @brief 开启或关闭跟踪, 默认关闭
+  */
+  static void setEnabled(bool enable);
+
+  /*!
+  * @brief 记录当前线程的一个阶段
+  * @param[in] begin 开始时间::now
+  * @param[in] end   结束时间::now
+  */
+  static void record(TraceStage stage, uint64_t begin, uint64_t end);
+
+  /*!
+  * @brief 设置当前线程在跟踪文件中的名称
+  * @note 在线程开始时调用, 复用已退出的同名线程的缓冲区
+  */
+  static void setThreadName(const char *name);
+
+  /*!
+  * @brief 导出全部线程缓冲区中的事件
+  * @param[in] path JSON文件路径
+  * @return 成功返回true
+  */
+  static bool dump(const std::string &path);
+
+  /*!
+  * @brief 清空全部线程缓冲区
+  * @note 在没有线程记录事件时调用
+  */
+  static void clear();
+
+  /*!
+  * @brief 跟踪时钟[ns], 单调递增
+  */
+  static uint64_t now();
+
+ private:
+  static std::atomic<bool> s_enabled;
+};
+
+/*!
+* 在作用域内记录一个阶段
+*/
+class TraceScope {
+ public:
+  explicit TraceScope(TraceStage stage)
+    : _stage(stage), _begin(Tracer::enabled() ? Tracer::now() : 0) {}
+
+  ~TraceScope() {
+    if (_begin) {
+      Tracer::record(_stage, _begin, Tracer::now());
+    }
+  }
+
+ private:
+  TraceScope(const TraceScope &);
+  TraceScope &operator=(const TraceScope &);
+
+  TraceStage _stage;
+  uint64_t   _begin;
+};
+
+}// namespace ydlidar
+
+#define YDLIDAR_TRACE_CONCAT_(a, b) a##b
+#define YDLIDAR_TRACE_CONCAT(a, b) YDLIDAR_TRACE_CONCAT_(a, b)
+/// 跟踪当前作用域
+#define YDLIDAR_TRACE_SCOPE(stage) \
+  ydlidar::TraceScope YDLIDAR_TRACE_CONCAT(ydlidar_trace_, __LINE__)(stage)
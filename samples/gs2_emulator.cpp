@@ -0,0 +1,439 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+/*!
+* GS2雷达模拟器 \n
+* 在Linux伪终端上模拟三模组GS2雷达, 应答驱动使用的命令并按指定频率发送数据包,
+* 可注入噪声、校验错误、丢包和停顿, 用于无雷达环境下的压力和性能测试
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <errno.h>
+#include <signal.h>
+#include <getopt.h>
+#include <termios.h>
+#include <time.h>
+#include <math.h>
+#include <vector>
+#include "ydlidar_protocol.h"
+#include "test/test_stream.h"
+
+using namespace ydlidar;
+
+namespace {
+
+const int ModuleNums = PackageMaxModuleNums;
+
+struct Options {
+    const char *link;   ///< 伪终端符号链接
+    double rate;        ///< 每个模组每秒数据包数
+    double noise;       ///< 数据包前插入随机字节的概率
+    double crc_error;   ///< 校验和错误的概率
+    double dropout;     ///< 丢包概率
+    int stall_every;    ///< 每发送N个数据包停顿一次, 0不停顿
+    int stall_ms;       ///< 停顿时长[ms]
+    unsigned seed;      ///< 随机数种子
+    bool verbose;       ///< 打印收到的命令
+};
+
+volatile sig_atomic_t running = 1;
+
+void onSignal(int) {
+    running = 0;
+}
+
+uint64_t nowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+double uniform() {
+    return rand() / (RAND_MAX + 1.0);
+}
+
+class Emulator {
+ public:
+    Emulator(int fd, const Options &opt)
+        : fd_(fd), opt_(opt), scanning_(false), module_(0), sent_(0),
+          frame_(0), parse_pos_(0) {
+        memset(&header_, 0, sizeof(header_));
+    }
+
+    void run() {
+        uint64_t period = uint64_t(1e9 / (opt_.rate * ModuleNums));
+        uint64_t next_tx = nowNs();
+
+        while (running) {
+            int wait_ms = 100;
+
+            if (scanning_) {
+                uint64_t now = nowNs();
+                wait_ms = now >= next_tx ? 0 : int((next_tx - now) / 1000000);
+            }
+
+            pollfd pfd = {fd_, POLLIN, 0};
+            int r = poll(&pfd, 1, wait_ms);
+
+            if (r < 0 && errno != EINTR) {
+                perror("poll");
+                return;
+            }
+
+            if (r > 0 && (pfd.revents & POLLIN)) {
+                uint8_t buf[512];
+                ssize_t n = read(fd_, buf, sizeof(buf));
+
+                for (ssize_t i = 0; i < n; ++i) {
+                    parse(buf[i]);
+                }
+            }
+
+            if (!scanning_) {
+                next_tx = nowNs();
+                continue;
+            }
+
+            uint64_t now = nowNs();
+
+            if (now < next_tx) {
+                continue;
+            }
+
+            next_tx += period;
+
+            //落后太多时不补发
+            if (now > next_tx + 100 * period) {
+                next_tx = now + period;
+            }
+
+            sendScanPackage();
+        }
+    }
+
+ private:
+    /// 解析命令: 同步字 + 地址 + 命令 + 长度 + 数据 + 校验和
+    void parse(uint8_t byte) {
+        uint8_t *header = reinterpret_cast<uint8_t *>(&header_);
+
+        if (parse_pos_ < 4) {
+            parse_pos_ = byte == LIDAR_ANS_SYNC_BYTE1 ? parse_pos_ + 1 : 0;
+            return;
+        }
+
+        if (parse_pos_ < sizeof(cmd_packet_gs)) {
+            header[parse_pos_++] = byte;
+            payload_.clear();
+            return;
+        }
+
+        if (payload_.size() < header_.size) {
+            payload_.push_back(byte);
+            return;
+        }
+
+        //校验和结束一条命令
+        handleCommand(header_.address, header_.cmd_flag);
+        parse_pos_ = 0;
+    }
+
+    void handleCommand(uint8_t address, uint8_t cmd) {
+        if (opt_.verbose) {
+            fprintf(stderr, "[emulator] command 0x%02X address 0x%02X\n", cmd, address);
+        }
+
+        switch (cmd) {
+        case GS_LIDAR_CMD_GET_ADDRESS:
+            //驱动只读取一个应答, 模组数为(address << 1) + 1
+            sendResponse((ModuleNums - 1) >> 1, cmd, NULL, 0);
+            break;
+
+        case GS_LIDAR_CMD_GET_PARAMETER: {
+            std::vector<uint8_t> frame;
+            test::appendDevicePara(frame);
+            writeAll(&frame[0], frame.size());
+            break;
+        }
+
+        case GS_LIDAR_CMD_GET_VERSION: {
+            std::vector<uint8_t> frame;
+            test::appendVersion(frame);
+            writeAll(&frame[0], frame.size());
+            break;
+        }
+
+        case GS_LIDAR_CMD_SCAN:
+            sendResponse(0x00, cmd, NULL, 0);
+            scanning_ = true;
+            break;
+
+        case GS_LIDAR_CMD_STOP:
+            scanning_ = false;
+            sendResponse(0x00, cmd, NULL, 0);
+            break;
+
+        case GS_LIDAR_CMD_RESET:
+            scanning_ = false;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void sendResponse(uint8_t address, uint8_t type, const uint8_t *payload,
+                      uint16_t size) {
+        std::vector<uint8_t> frame;
+        test::appendResponse(frame, address, type, payload, size);
+        writeAll(&frame[0], frame.size());
+    }
+
+    void sendScanPackage() {
+        uint8_t address = test::ModuleAddress[module_];
+        module_ = (module_ + 1) % ModuleNums;
+
+        if (module_ == 0) {
+            frame_++;
+        }
+
+        sent_++;
+
+        if (opt_.stall_every > 0 && sent_ % opt_.stall_every == 0) {
+            usleep(opt_.stall_ms * 1000);
+        }
+
+        if (uniform() < opt_.dropout) {
+            return;
+        }
+
+        if (uniform() < opt_.noise) {
+            uint8_t garbage[32];
+            size_t n = 1 + rand() % sizeof(garbage);
+
+            for (size_t i = 0; i < n; ++i) {
+                garbage[i] = uniform() < 0.25 ? LIDAR_ANS_SYNC_BYTE1 : uint8_t(rand());
+            }
+
+            writeAll(garbage, n);
+        }
+
+        gs2_node_package package;
+        test::makePackage(package, address, frame_);
+        uint8_t *data = reinterpret_cast<uint8_t *>(&package);
+
+        if (uniform() < opt_.crc_error) {
+            package.checkSum ^= 0x5A;
+        }
+
+        writeAll(data, sizeof(package));
+    }
+
+    void writeAll(const uint8_t *data, size_t size) {
+        while (size) {
+            ssize_t n = write(fd_, data, size);
+
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                if (errno == EAGAIN) {
+                    usleep(1000);
+                    continue;
+                }
+
+                return;
+            }
+
+            data += n;
+            size -= n;
+        }
+    }
+
+ private:
+    int fd_;
+    Options opt_;
+    bool scanning_;
+    int module_;                ///< 下一个发送数据的模组
+    uint64_t sent_;             ///< 已发送数据包数
+    uint64_t frame_;            ///< 帧序号
+    size_t parse_pos_;          ///< 命令解析位置
+    cmd_packet_gs header_;      ///< 正在解析的命令头
+    std::vector<uint8_t> payload_;
+};
+
+void usage(const char *name) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  -l, --link PATH      symlink the emulated port to PATH\n"
+            "  -r, --rate HZ        packets per second per module (default 30)\n"
+            "  -n, --noise P        probability of garbage bytes before a packet\n"
+            "  -c, --crc-error P    probability of a corrupted checksum\n"
+            "  -d, --dropout P      probability of a dropped packet\n"
+            "  -s, --stall N:MS     stall MS milliseconds after every N packets\n"
+            "  -S, --seed N         random seed\n"
+            "  -v, --verbose        log received commands\n",
+            name);
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    Options opt;
+    opt.link = NULL;
+    opt.rate = 30;
+    opt.noise = 0;
+    opt.crc_error = 0;
+    opt.dropout = 0;
+    opt.stall_every = 0;
+    opt.stall_ms = 0;
+    opt.seed = 1;
+    opt.verbose = false;
+
+    static const option long_options[] = {
+        {"link", required_argument, NULL, 'l'},
+        {"rate", required_argument, NULL, 'r'},
+        {"noise", required_argument, NULL, 'n'},
+        {"crc-error", required_argument, NULL, 'c'},
+        {"dropout", required_argument, NULL, 'd'},
+        {"stall", required_argument, NULL, 's'},
+        {"seed", required_argument, NULL, 'S'},
+        {"verbose", no_argument, NULL, 'v'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int c;
+
+    while ((c = getopt_long(argc, argv, "l:r:n:c:d:s:S:vh", long_options,
+                            NULL)) != -1) {
+        switch (c) {
+        case 'l':
+            opt.link = optarg;
+            break;
+
+        case 'r':
+            opt.rate = atof(optarg);
+            break;
+
+        case 'n':
+            opt.noise = atof(optarg);
+            break;
+
+        case 'c':
+            opt.crc_error = atof(optarg);
+            break;
+
+        case 'd':
+            opt.dropout = atof(optarg);
+            break;
+
+        case 's':
+            if (sscanf(optarg, "%d:%d", &opt.stall_every, &opt.stall_ms) != 2) {
+                usage(argv[0]);
+                return 1;
+            }
+
+            break;
+
+        case 'S':
+            opt.seed = strtoul(optarg, NULL, 10);
+            break;
+
+        case 'v':
+            opt.verbose = true;
+            break;
+
+        default:
+            usage(argv[0]);
+            return c == 'h' ? 0 : 1;
+        }
+    }
+
+    if (opt.rate <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    srand(opt.seed);
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("posix_openpt");
+        return 1;
+    }
+
+    const char *slave_name = ptsname(master);
+    //保持从端打开, 驱动重连时主端不会挂断
+    int slave = open(slave_name, O_RDWR | O_NOCTTY);
+
+    if (slave < 0) {
+        perror("open slave");
+        return 1;
+    }
+
+    termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    if (opt.link) {
+        unlink(opt.link);
+
+        if (symlink(slave_name, opt.link) != 0) {
+            perror("symlink");
+            return 1;
+        }
+    }
+
+    printf("%s\n", opt.link ? opt.link : slave_name);
+    fflush(stdout);
+
+    Emulator emulator(master, opt);
+    emulator.run();
+
+    if (opt.link) {
+        unlink(opt.link);
+    }
+
+    close(slave);
+    close(master);
+    return 0;
+}
@@ -36,6 +36,7 @@
 #include <map>
 #include <angles.h>
 #include <numeric>
+#include <algorithm>
 //#include <iostream>
 
 using namespace std;
@@ -78,6 +79,31 @@ CYdLidar::CYdLidar(): lidarPtr(nullptr) {
     last_node_time = getTime();
     global_nodes = new node_info[YDlidarDriver::MAX_SCAN_NODES];
     m_ParseSuccess = false;
+    m_ModuleAngleOffset.clear();
+    angle_mask_dirty    = true;
+    angle_mask_min      = m_MinAngle;
+    angle_mask_max      = m_MaxAngle;
+    angle_mask_scale    = 0;
+    m_MergePolicy       = MERGE_WAIT;
+    m_MergeTimeout      = 100;
+    m_RecordFile        = "";
+    m_ReplayFile        = "";
+    m_CalibrationCache  = "";
+    m_ReplaySpeed       = 1.0;
+    m_DeskewMode        = DESKEW_OFF;
+    deskew_pose_func    = NULL;
+    deskew_pose_user    = NULL;
+    merge_mask          = 0;
+    merge_seen_mask     = 0;
+    merge_start_time    = 0;
+
+    for (int i = 0; i < PackageMaxModuleNums; i++) {
+        merge_points[i].reserve(PackageSampleMaxLngth_GS);
+        merge_stamps[i] = 0;
+    }
+
+    merge_sorted.reserve(PackageMaxModuleNums * PackageSampleMaxLngth_GS);
+    merge_offsets.reserve(PackageMaxModuleNums * PackageSampleMaxLngth_GS);
 }
 
 /*-------------------------------------------------------------
@@ -131,6 +157,80 @@ bool CYdLidar::reset(uint8_t addr)
     return (RESULT_OK == lidarPtr->reset(addr));
 }
 
+bool CYdLidar::resetModules(uint8_t mask)
+{
+    if (!lidarPtr)
+        return false;
+
+    return (RESULT_OK == lidarPtr->resetModules(mask));
+}
+
+void CYdLidar::getMetrics(LidarMetrics &metrics) const {
+    if (!lidarPtr) {
+        memset(&metrics, 0, sizeof(metrics));
+        return;
+    }
+
+    lidarPtr->getMetrics(metrics);
+}
+
+void CYdLidar::resetMetrics() {
+    if (lidarPtr) {
+        lidarPtr->resetMetrics();
+    }
+}
+
+void CYdLidar::setDeskewPoseCallback(DeskewPoseFunc func, void *user) {
+    deskew_pose_func = func;
+    deskew_pose_user = user;
+}
+
+void CYdLidar::addDeskewTwist(const LidarTwist &twist) {
+    deskew_twists.push(twist);
+}
+
+void CYdLidar::deskewScan(uint64_t stamp, void *angles, void *ranges,
+                          size_t stride, const float *timeOffsets, size_t count) {
+    if (m_DeskewMode == DESKEW_OFF || !count) {
+        return;
+    }
+
+    float duration = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        duration = std::max(duration, timeOffsets[i]);
+    }
+
+    if (duration <= 0) {
+        return;
+    }
+
+    uint64_t end = stamp + static_cast<uint64_t>(duration * 1e9);
+    DeskewMotion motion;
+
+    if (m_DeskewMode == DESKEW_POSE) {
+        LidarPose2D ref, last;
+
+        if (!deskew_pose_func || !deskew_pose_func(stamp, &ref, deskew_pose_user) ||
+                !deskew_pose_func(end, &last, deskew_pose_user)) {
+            return;
+        }
+
+        deskewMotionFromPoses(ref, last, duration, motion);
+    } else if (m_DeskewMode == DESKEW_TWIST) {
+        if (!deskew_twists.motion(stamp, end, motion)) {
+            return;
+        }
+    } else {
+        return;
+    }
+
+    //速度为m/s, 距离为mm
+    motion.vx *= 1000;
+    motion.vy *= 1000;
+    deskewPoints(angles, ranges, stride, timeOffsets, count, motion);
+}
+
 bool CYdLidar::isRangeValid(double reading) const {
     if (reading >= m_MinRange && reading <= m_MaxRange) {
         return true;
@@ -139,10 +239,104 @@ bool CYdLidar::isRangeValid(double reading) const {
     return false;
 }
 
+void CYdLidar::setIgnoreArray(const std::vector<float> &v) {
+    m_IgnoreArray = v;
+    angle_mask_dirty = true;
+}
+
+//边界限制在[-π, π]内, 与::toLaserPoint 中归一化后的比较一致, 宽度大于π时对半拆分
+static void addAngleSector(std::vector<AngleSector> &sectors, double lo,
+                           double hi) {
+    lo = std::max(lo, -M_PI);
+    hi = std::min(hi, M_PI);
+
+    if (lo > hi) {
+        return;
+    }
+
+    if (hi - lo > M_PI) {
+        double mid = (lo + hi) / 2;
+        addAngleSector(sectors, lo, mid);
+        addAngleSector(sectors, mid, hi);
+        return;
+    }
+
+    AngleSector sector;
+    sector.lo_x = static_cast<float>(cos(lo));
+    sector.lo_y = static_cast<float>(sin(lo));
+    sector.hi_x = static_cast<float>(cos(hi));
+    sector.hi_y = static_cast<float>(sin(hi));
+    sectors.push_back(sector);
+}
+
+static bool inAngleSectors(const std::vector<AngleSector> &sectors, float x,
+                           float y) {
+    for (size_t i = 0; i < sectors.size(); i++) {
+        if (sectors[i].contains(x, y)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CYdLidar::updateAngleMask() {
+    if (!angle_mask_dirty && angle_mask_min == m_MinAngle &&
+            angle_mask_max == m_MaxAngle) {
+        return;
+    }
+
+    const int size = static_cast<int>(360 / AngleMaskResolution + 0.5);
+    const double step = 2 * M_PI / size;
+    double min_angle = angles::from_degrees(m_MinAngle);
+    double max_angle = angles::from_degrees(m_MaxAngle);
+    angle_mask.assign(size, 0);
+
+    for (int i = 0; i < size; i++) {
+        //相邻项一并计入, 避免角度换算序号时的舍入误差
+        double lo = -M_PI + (i - 1) * step;
+        double hi = -M_PI + (i + 2) * step;
+        uint8_t flag = 0;
+
+        if (hi < min_angle || lo > max_angle) {
+            flag |= ANGLE_MASK_OUTSIDE;
+        } else if (lo < min_angle || hi > max_angle) {
+            flag |= ANGLE_MASK_EXACT;
+        }
+
+        for (size_t j = 0; j + 1 < m_IgnoreArray.size(); j = j + 2) {
+            double ignore_min = angles::from_degrees(m_IgnoreArray[j]);
+            double ignore_max = angles::from_degrees(m_IgnoreArray[j + 1]);
+
+            if (ignore_min <= lo && hi <= ignore_max) {
+                flag |= ANGLE_MASK_IGNORE;
+            } else if (hi >= ignore_min && lo <= ignore_max) {
+                flag |= ANGLE_MASK_EXACT;
+            }
+        }
+
+        angle_mask[i] = flag;
+    }
+
+    angle_sectors.clear();
+    ignore_sectors.clear();
+    addAngleSector(angle_sectors, min_angle, max_angle);
+
+    for (size_t j = 0; j + 1 < m_IgnoreArray.size(); j = j + 2) {
+        addAngleSector(ignore_sectors, angles::from_degrees(m_IgnoreArray[j]),
+                       angles::from_degrees(m_IgnoreArray[j + 1]));
+    }
+
+    angle_mask_scale = static_cast<float>(size / (2 * M_PI));
+    angle_mask_dirty = false;
+    angle_mask_min = m_MinAngle;
+    angle_mask_max = m_MaxAngle;
+}
+
 bool CYdLidar::isRangeIgnore(double angle) const {
     bool ret = false;
 
-    for (uint16_t j = 0; j < m_IgnoreArray.size(); j = j + 2) {
+    for (size_t j = 0; j + 1 < m_IgnoreArray.size(); j = j + 2) {
         if ((angles::from_degrees(m_IgnoreArray[j]) <= angle) &&
                 (angle <= angles::from_degrees(m_IgnoreArray[j + 1]))) {
             ret = true;
@@ -159,6 +353,7 @@ bool CYdLidar::isRangeIgnore(double angle) const {
 -------------------------------------------------------------*/
 bool  CYdLidar::doProcessSimple(LaserScan &outscan,
                                 bool &hardwareError) {
+    YDLIDAR_TRACE_SCOPE(TRACE_PROCESS);
     hardwareError = false;
 
     // Bound?
@@ -168,121 +363,516 @@ bool  CYdLidar::doProcessSimple(LaserScan &outscan,
         return false;
     }
 
-    size_t count = YDlidarDriver::MAX_SCAN_NODES;
+    lidarPtr->setPolarTransform(true);
+    updateAngleMask();
+
     //wait Scan data:
     uint64_t tim_scan_start = getTime();
     uint64_t startTs = tim_scan_start;
-    result_t op_result = lidarPtr->grabScanData(global_nodes, count);
+    result_t op_result = lidarPtr->grabScanData(scan_frame);
     uint64_t tim_scan_end = getTime();
 
-    int moduleNum = 0;
     // Fill in scan data:
     if (IS_OK(op_result))
     {
-        outscan.moduleNum = global_nodes[0].index;
-        moduleNum = outscan.moduleNum;
-        if(moduleNum >= 3){
-            moduleNum = 0;
+        size_t count = scan_frame.count;
+        outscan.moduleNum = scan_frame.module;
+        int all_node_count = fillScanConfig(outscan.config,
+                                            tim_scan_end - startTs, count);
+        outscan.stamp = scan_frame.stamp(0);
+        outscan.points.clear();
+        outscan.timeOffsets.clear();
+
+        LaserPoint point;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (toLaserPoint(scan_frame.points[i], 0, point))
+            {
+                if (outscan.points.empty()) {
+                    outscan.stamp = scan_frame.stamp(i);
+                }
+
+                if (m_FixedResolution) {
+                    int index = std::ceil((point.angle - outscan.config.min_angle) /
+                                          outscan.config.angle_increment);
+
+                    if (index < 0 || index >= all_node_count) {
+                        continue;
+                    }
+                }
+
+                outscan.points.push_back(point);
+                outscan.timeOffsets.push_back(
+                    static_cast<float>((scan_frame.stamp(i) - outscan.stamp) / 1e9));
+            }
         }
-        int all_node_count = count;
-        uint64_t scan_time  =   tim_scan_end - startTs;
 
-        outscan.config.min_angle = angles::from_degrees(m_MinAngle);
-        outscan.config.max_angle = angles::from_degrees(m_MaxAngle);
-        outscan.config.scan_time = static_cast<float>(scan_time * 1.0 / 1e9);
-        outscan.config.time_increment = outscan.config.scan_time / (double)(count - 1);
-        outscan.config.min_range = m_MinRange;
-        outscan.config.max_range = m_MaxRange;
-        outscan.stamp = tim_scan_start;
-        outscan.points.clear();
+        if (!outscan.points.empty()) {
+            uint8_t *points = reinterpret_cast<uint8_t *>(&outscan.points[0]);
+            deskewScan(outscan.stamp, points + offsetof(LaserPoint, angle),
+                       points + offsetof(LaserPoint, range), sizeof(LaserPoint),
+                       &outscan.timeOffsets[0], outscan.points.size());
+        }
 
         if (m_FixedResolution) {
-            all_node_count = m_FixedSize;
+            outscan.points.resize(all_node_count);
+            outscan.timeOffsets.resize(all_node_count);
         }
 
-        outscan.config.angle_increment = (outscan.config.max_angle -
-                                          outscan.config.min_angle) / (all_node_count - 1);
+        outscan.monotonicStamp = outscan.stamp - lidarPtr->getScanClockOffset();
 
-        float range = 0.0;
-        float intensity = 0.0;
-        float angle = 0.0;
+        //   handleDeviceInfoPackage(count);
 
-//        printf("points %lu\n", count);
-        for (size_t i = 0; i < count; i++)
-        {
-            angle = static_cast<float>((global_nodes[i].angle_q6_checkbit >>
-                                        LIDAR_RESP_MEASUREMENT_ANGLE_SHIFT) / 64.0f) + m_AngleOffset;
-            range = static_cast<float>(global_nodes[i].distance_q2);
+        return true;
+    } else {
+        if (IS_FAIL(op_result)) {
+            // Error? Retry connection
+        }
+    }
 
-            intensity = static_cast<float>(global_nodes[i].sync_quality);
-            angle = angles::from_degrees(angle);
+    return false;
 
-            //Rotate 180 degrees or not
-            if (m_Reversion) {
-                angle = angle + M_PI;
-            }
+}
 
-            //Is it counter clockwise
-            if (m_Inverted) {
-                angle = 2 * M_PI - angle;
-            }
+bool CYdLidar::toLaserPoint(const GS2Point &node, float angleOffset,
+                            LaserPoint &point) const {
+    float angle = static_cast<float>((node.angle_q6_checkbit >>
+                                      LIDAR_RESP_MEASUREMENT_ANGLE_SHIFT) / 64.0f) + m_AngleOffset + angleOffset;
+    float range = static_cast<float>(node.distance_q2);
+    float intensity = static_cast<float>(node.quality);
+    angle = angles::from_degrees(angle);
+
+    //Rotate 180 degrees or not
+    if (m_Reversion) {
+        angle = angle + M_PI;
+    }
+
+    //Is it counter clockwise
+    if (m_Inverted) {
+        angle = 2 * M_PI - angle;
+    }
+
+    angle = angles::normalize_anglef(angle);
+
+    bool ignore = false;
+    bool inside = true;
+    int index = static_cast<int>((angle + static_cast<float>(M_PI)) * angle_mask_scale);
+
+    if (index >= (int)angle_mask.size()) {
+        index = angle_mask.size() - 1;
+    }
+
+    uint8_t flag = angle_mask.empty() ? (uint8_t)ANGLE_MASK_EXACT : angle_mask[index];
+
+    if (flag & ANGLE_MASK_EXACT) {
+        ignore = isRangeIgnore(angle);
+        inside = angle >= static_cast<float>(angles::from_degrees(m_MinAngle)) &&
+                 angle <= static_cast<float>(angles::from_degrees(m_MaxAngle));
+    } else {
+        ignore = flag & ANGLE_MASK_IGNORE;
+        inside = !(flag & ANGLE_MASK_OUTSIDE);
+    }
+
+    //ignore angle
+    if (ignore) {
+        range = 0.0;
+    }
+
+    //valid range
+    if (!isRangeValid(range)) {
+        range = 0.0;
+        intensity = 0.0;
+    }
+
+    point.angle = angle;
+    point.range = range;
+    point.intensity = intensity;
+
+    return inside;
+}
+
+bool  CYdLidar::doProcessSimple(LaserScanArrays &outscan,
+                                bool &hardwareError) {
+    YDLIDAR_TRACE_SCOPE(TRACE_PROCESS);
+    hardwareError = false;
+
+    // Bound?
+    if (!checkHardware()) {
+        hardwareError = true;
+        delay(200 / m_ScanFrequency);
+        return false;
+    }
+
+    lidarPtr->setPolarTransform(true);
+    updateAngleMask();
+
+    //wait Scan data:
+    uint64_t tim_scan_start = getTime();
+    result_t op_result = lidarPtr->grabScanData(scan_frame);
+    uint64_t tim_scan_end = getTime();
+
+    if (!IS_OK(op_result)) {
+        return false;
+    }
+
+    size_t count = scan_frame.count;
+    outscan.moduleNum = scan_frame.module;
+    int all_node_count = fillScanConfig(outscan.config,
+                                        tim_scan_end - tim_scan_start, count);
+    outscan.stamp = scan_frame.stamp(0);
+    outscan.clear();
+    //首次调用后容量不再变化
+    outscan.reserve(std::max<size_t>(count, all_node_count));
+
+    LaserPoint point;
 
-            angle = angles::normalize_angle(angle);
-//            angle = angles::normalize_angle_positive(angle);
+    for (size_t i = 0; i < count; i++) {
+        if (!toLaserPoint(scan_frame.points[i], 0, point)) {
+            continue;
+        }
+
+        if (!outscan.size()) {
+            outscan.stamp = scan_frame.stamp(i);
+        }
+
+        if (m_FixedResolution) {
+            int index = std::ceil((point.angle - outscan.config.min_angle) /
+                                  outscan.config.angle_increment);
 
-            //ignore angle
-            if (isRangeIgnore(angle)) {
-                range = 0.0;
+            if (index < 0 || index >= all_node_count) {
+                continue;
             }
+        }
+
+        outscan.push_back(point.angle, point.range, point.intensity,
+                          static_cast<float>((scan_frame.stamp(i) - outscan.stamp) / 1e9));
+    }
+
+    if (outscan.size()) {
+        deskewScan(outscan.stamp, &outscan.angles[0], &outscan.ranges[0], sizeof(float),
+                   &outscan.timeOffsets[0], outscan.size());
+    }
+
+    if (m_FixedResolution) {
+        outscan.resize(all_node_count);
+    }
+
+    outscan.monotonicStamp = outscan.stamp - lidarPtr->getScanClockOffset();
+    return true;
+}
+
+bool  CYdLidar::doProcessSimple(LaserScanCartesian &outscan,
+                                bool &hardwareError) {
+    YDLIDAR_TRACE_SCOPE(TRACE_PROCESS);
+    hardwareError = false;
+
+    // Bound?
+    if (!checkHardware()) {
+        hardwareError = true;
+        delay(200 / m_ScanFrequency);
+        return false;
+    }
+
+    lidarPtr->setPolarTransform(false);
+    updateAngleMask();
+
+    //wait Scan data:
+    uint64_t tim_scan_start = getTime();
+    result_t op_result = lidarPtr->grabScanData(scan_frame);
+    uint64_t tim_scan_end = getTime();
+
+    if (!IS_OK(op_result)) {
+        return false;
+    }
+
+    size_t count = scan_frame.count;
+    lidarPtr->cartesianPoints(scan_frame);
+    outscan.moduleNum = scan_frame.module;
+    fillScanConfig(outscan.config, tim_scan_end - tim_scan_start, count);
+    outscan.stamp = scan_frame.stamp(0);
+    outscan.points.clear();
+    outscan.timeOffsets.clear();
+
+    //模组坐标系到雷达坐标系: 按零位偏移旋转, 旋转180度时再转π, 逆时针时关于x轴镜像
+    double rotation = angles::from_degrees(m_AngleOffset);
+
+    if (m_Reversion) {
+        rotation += M_PI;
+    }
 
-            //valid range
-            if (!isRangeValid(range)) {
-                range = 0.0;
-                intensity = 0.0;
+    const float c = static_cast<float>(cos(rotation));
+    const float s = static_cast<float>(sin(rotation));
+    const float mirror = m_Inverted ? -1.0f : 1.0f;
+    //距离范围按距离平方比较
+    const float min_range2 = m_MinRange > 0 ? m_MinRange * m_MinRange : 0;
+    const float max_range2 = m_MaxRange >= 0 ? m_MaxRange * m_MaxRange : -1;
+
+    LaserCartesianPoint xy;
+
+    for (size_t i = 0; i < count; i++) {
+        float x = scan_frame.x[i];
+        float y = scan_frame.y[i];
+        //前80个点应在y < 0一侧, 后80个点在y >= 0一侧, 同驱动的越界判断
+        bool measured = x > 0 && (i < 80 ? y < 0 : y >= 0);
+
+        //距离为0的点按模组0度方向判断角度范围
+        if (!(x > 0)) {
+            x = 1;
+            y = 0;
+        }
+
+        float px = c * x - s * y;
+        float py = mirror * (s * x + c * y);
+
+        if (!inAngleSectors(angle_sectors, px, py)) {
+            continue;
+        }
+
+        if (outscan.points.empty()) {
+            outscan.stamp = scan_frame.stamp(i);
+        }
+
+        float range2 = 0;
+
+        if (measured && !inAngleSectors(ignore_sectors, px, py)) {
+            range2 = x * x + y * y;
+        }
+
+        xy.x = 0;
+        xy.y = 0;
+        xy.intensity = 0;
+
+        if (range2 >= min_range2 && range2 <= max_range2) {
+            xy.intensity = m_Intensity ? scan_frame.samples[i].PakageSampleQuality :
+                           Node_Default_Quality;
+
+            if (range2 > 0) {
+                xy.x = px;
+                xy.y = py;
             }
+        }
 
-//            printf("%lu %f %f\n", i, angles::to_degrees(angle), range);
+        outscan.points.push_back(xy);
+        outscan.timeOffsets.push_back(
+            static_cast<float>((scan_frame.stamp(i) - outscan.stamp) / 1e9));
+    }
 
-            if (angle >= outscan.config.min_angle &&
-                angle <= outscan.config.max_angle)
-            {
-                LaserPoint point;
-                point.angle = angle;
-                point.range = range;
-                point.intensity = intensity;
+    outscan.monotonicStamp = outscan.stamp - lidarPtr->getScanClockOffset();
+    return true;
+}
 
-                if (outscan.points.empty()) {
-                    outscan.stamp = tim_scan_start + i * m_PointTime;
-                }
+int CYdLidar::fillScanConfig(LaserConfig &config, uint64_t scan_time,
+                             size_t count) const {
+    int all_node_count = count;
 
-                if (m_FixedResolution) {
-                    int index = std::ceil((angle - outscan.config.min_angle) /
-                                          outscan.config.angle_increment);
+    if (m_FixedResolution) {
+        all_node_count = m_FixedSize;
+    }
 
-                    if (index >= 0 && index < all_node_count) {
-                        outscan.points.push_back(point);
-                    }
-                } else {
-                    outscan.points.push_back(point);
+    config.min_angle = angles::from_degrees(m_MinAngle);
+    config.max_angle = angles::from_degrees(m_MaxAngle);
+    config.scan_time = static_cast<float>(scan_time * 1.0 / 1e9);
+    config.time_increment = config.scan_time / (double)(count - 1);
+    config.min_range = m_MinRange;
+    config.max_range = m_MaxRange;
+    config.angle_increment = (config.max_angle - config.min_angle) /
+                             (all_node_count - 1);
+    return all_node_count;
+}
+
+static bool laserPointAngleLess(const MergedLaserPoint &a,
+                                const MergedLaserPoint &b) {
+    return a.point.angle < b.point.angle;
+}
+
+/*-------------------------------------------------------------
+                        doProcessMerged
+-------------------------------------------------------------*/
+bool CYdLidar::doProcessMerged(LaserScan &outscan, bool &hardwareError) {
+    YDLIDAR_TRACE_SCOPE(TRACE_PROCESS);
+    hardwareError = false;
+
+    // Bound?
+    if (!checkHardware()) {
+        hardwareError = true;
+        delay(200 / m_ScanFrequency);
+        return false;
+    }
+
+    lidarPtr->setPolarTransform(true);
+    updateAngleMask();
+
+    while (isScanning) {
+        uint32_t timeout = YDlidarDriver::DEFAULT_TIMEOUT;
+
+        //当前帧等待超时
+        if (merge_mask) {
+            uint64_t elapsed = (getTime() - merge_start_time) / 1000000;
+
+            if (elapsed >= (uint64_t)m_MergeTimeout) {
+                if (finishMergedFrame(outscan, false)) {
+                    return true;
                 }
+
+                continue;
             }
+
+            timeout = m_MergeTimeout - elapsed;
         }
 
-        if (m_FixedResolution) {
-            outscan.points.resize(all_node_count);
+        result_t op_result = lidarPtr->grabScanData(scan_frame, timeout);
+        uint64_t packet_time = getTime();
+
+        if (op_result == RESULT_TIMEOUT && merge_mask) {
+            continue;
         }
 
-        //   handleDeviceInfoPackage(count);
+        if (!IS_OK(op_result)) {
+            return false;
+        }
 
-        return true;
-    } else {
-        if (IS_FAIL(op_result)) {
-            // Error? Retry connection
+        int moduleNum = scan_frame.module;
+
+        if (moduleNum < 0 || moduleNum >= PackageMaxModuleNums) {
+            continue;
+        }
+
+        uint8_t bit = 1 << moduleNum;
+        merge_seen_mask |= bit;
+
+        //模组在当前帧内重复, 当前数据包作为下一帧的第一个数据包
+        if ((merge_mask & bit) && m_MergePolicy != MERGE_WAIT) {
+            bool emitted = finishMergedFrame(outscan, false);
+            addMergedModule(moduleNum, packet_time);
+
+            if (emitted) {
+                return true;
+            }
+
+            continue;
+        }
+
+        addMergedModule(moduleNum, packet_time);
+
+        //未获取到模组参数时以出现过的模组为准
+        uint8_t expected = lidarPtr->getModuleMask();
+
+        if (!expected) {
+            expected = merge_seen_mask;
+        }
+
+        if ((merge_mask & expected) == expected) {
+            return finishMergedFrame(outscan, true);
         }
     }
 
     return false;
+}
+
+void CYdLidar::addMergedModule(int moduleNum, uint64_t stamp) {
+    MergedLaserPoint point;
+    float angleOffset = moduleAngleOffset(moduleNum);
+
+    if (!merge_mask) {
+        merge_start_time = stamp;
+    }
+
+    merge_points[moduleNum].clear();
 
+    for (size_t i = 0; i < scan_frame.count; i++) {
+        if (toLaserPoint(scan_frame.points[i], angleOffset, point.point)) {
+            point.stamp = scan_frame.stamp(i);
+            merge_points[moduleNum].push_back(point);
+        }
+    }
+
+    merge_mask |= 1 << moduleNum;
+    merge_stamps[moduleNum] = stamp;
+}
+
+float CYdLidar::moduleAngleOffset(int moduleNum) const {
+    if (moduleNum < (int)m_ModuleAngleOffset.size()) {
+        return m_ModuleAngleOffset[moduleNum];
+    }
+
+    return 0.0;
+}
+
+bool CYdLidar::finishMergedFrame(LaserScan &outscan, bool complete) {
+    bool emitted = complete || m_MergePolicy != MERGE_DROP;
+
+    if (emitted) {
+        uint64_t first_stamp = 0;
+        uint64_t last_stamp = 0;
+        merge_sorted.clear();
+
+        for (int i = 0; i < PackageMaxModuleNums; i++) {
+            if (!(merge_mask & (1 << i))) {
+                outscan.moduleStamps[i] = 0;
+                continue;
+            }
+
+            outscan.moduleStamps[i] = merge_stamps[i];
+            merge_sorted.insert(merge_sorted.end(), merge_points[i].begin(),
+                                merge_points[i].end());
+        }
+
+        //按采集时间计算帧时间范围
+        for (size_t i = 0; i < merge_sorted.size(); i++) {
+            if (!first_stamp || merge_sorted[i].stamp < first_stamp) {
+                first_stamp = merge_sorted[i].stamp;
+            }
+
+            if (merge_sorted[i].stamp > last_stamp) {
+                last_stamp = merge_sorted[i].stamp;
+            }
+        }
+
+        size_t count = merge_sorted.size();
+
+        //排序前校正, 校正后的角度决定顺序
+        if (m_DeskewMode != DESKEW_OFF && count) {
+            merge_offsets.resize(count);
+
+            for (size_t i = 0; i < count; i++) {
+                merge_offsets[i] = static_cast<float>((merge_sorted[i].stamp -
+                                                       first_stamp) / 1e9);
+            }
+
+            uint8_t *points = reinterpret_cast<uint8_t *>(&merge_sorted[0]) +
+                              offsetof(MergedLaserPoint, point);
+            deskewScan(first_stamp, points + offsetof(LaserPoint, angle),
+                       points + offsetof(LaserPoint, range), sizeof(MergedLaserPoint),
+                       &merge_offsets[0], count);
+        }
+
+        std::sort(merge_sorted.begin(), merge_sorted.end(), laserPointAngleLess);
+
+        outscan.points.resize(count);
+        outscan.timeOffsets.resize(count);
+
+        for (size_t i = 0; i < count; i++) {
+            outscan.points[i] = merge_sorted[i].point;
+            outscan.timeOffsets[i] = static_cast<float>((merge_sorted[i].stamp -
+                                     first_stamp) / 1e9);
+        }
+
+        outscan.moduleNum = MergedModuleNum;
+        outscan.stamp = first_stamp;
+        outscan.monotonicStamp = first_stamp - lidarPtr->getScanClockOffset();
+        outscan.config.min_angle = angles::from_degrees(m_MinAngle);
+        outscan.config.max_angle = angles::from_degrees(m_MaxAngle);
+        outscan.config.scan_time = static_cast<float>((last_stamp - first_stamp) * 1.0 / 1e9);
+        outscan.config.time_increment = count > 1 ? outscan.config.scan_time / (double)(count - 1) : 0;
+        outscan.config.angle_increment = count > 1 ? (outscan.config.max_angle -
+                                         outscan.config.min_angle) / (count - 1) : 0;
+        outscan.config.min_range = m_MinRange;
+        outscan.config.max_range = m_MaxRange;
+    }
+
+    merge_mask = 0;
+    return emitted;
 }
 
 void CYdLidar::parsePackageNode(const node_info &node, LaserDebug &info) {
@@ -604,6 +1194,19 @@ bool  CYdLidar::checkCOMMs() {
         }
     }
 
+    if (!m_ReplayFile.empty()) {
+        lidarPtr->setSerial(new ReplaySerial(m_ReplayFile, m_ReplaySpeed),
+                            m_ReplaySpeed <= 0);
+    }
+
+    if (!m_RecordFile.empty() &&
+            !lidarPtr->startRecording(m_RecordFile, m_SerialBaudrate)) {
+        fprintf(stderr, "[CYdLidar] Failed to create record file[%s]\n",
+                m_RecordFile.c_str());
+    }
+
+    lidarPtr->setCalibrationCache(m_CalibrationCache);
+
     // make connection...
     result_t op_result = lidarPtr->connect(m_SerialPort.c_str(), m_SerialBaudrate);
 
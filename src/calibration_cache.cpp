@@ -0,0 +1,209 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+#include "calibration_cache.h"
+#include <stdio.h>
+
+namespace ydlidar {
+
+namespace {
+
+/// 缓存文件一行的最大长度
+const int kLineSize = 512;
+
+struct CacheLine {
+  std::string      port;
+  CalibrationEntry entry;
+};
+
+bool parseLine(const char *line, CacheLine &cache) {
+  char port[256];
+  char identity[256];
+  unsigned int address, k0, b0, k1, b1;
+  int bias;
+
+  if (sscanf(line, "%255s %u %255s %u %u %u %u %d", port, &address, identity,
+             &k0, &b0, &k1, &b1, &bias) != 8) {
+    return false;
+  }
+
+  if (address > 0xff || k0 > 0xffff || b0 > 0xffff || k1 > 0xffff ||
+      b1 > 0xffff || bias < -128 || bias > 127) {
+    return false;
+  }
+
+  cache.port = port;
+  cache.entry.address = uint8_t(address);
+  cache.entry.identity = identity;
+  cache.entry.para.u_compensateK0 = uint16_t(k0);
+  cache.entry.para.u_compensateB0 = uint16_t(b0);
+  cache.entry.para.u_compensateK1 = uint16_t(k1);
+  cache.entry.para.u_compensateB1 = uint16_t(b1);
+  cache.entry.para.bias = int8_t(bias);
+  cache.entry.para.crc = 0;
+  return true;
+}
+
+void readLines(const std::string &path, std::vector<CacheLine> &lines) {
+  FILE *file = fopen(path.c_str(), "r");
+
+  if (!file) {
+    return;
+  }
+
+  char line[kLineSize];
+  CacheLine cache;
+
+  while (fgets(line, sizeof(line), file)) {
+    if (parseLine(line, cache)) {
+      lines.push_back(cache);
+    }
+  }
+
+  fclose(file);
+}
+
+}
+
+std::string calibrationIdentity(const uint8_t *data, size_t size) {
+  static const char hex[] = "0123456789abcdef";
+  std::string identity;
+
+  if (!data || !size) {
+    return "-";
+  }
+
+  for (size_t i = 0; i < size; i++) {
+    identity += hex[data[i] >> 4];
+    identity += hex[data[i] & 0x0f];
+  }
+
+  return identity;
+}
+
+bool loadCalibrationCache(const std::string &path, const std::string &port,
+                          std::vector<CalibrationEntry> &entries) {
+  std::vector<CacheLine> lines;
+  readLines(path, lines);
+  entries.clear();
+
+  for (size_t i = 0; i < lines.size(); i++) {
+    if (lines[i].port == port) {
+      entries.push_back(lines[i].entry);
+    }
+  }
+
+  return !entries.empty();
+}
+
+bool storeCalibrationCache(const std::string &path, const std::string &port,
+                           const std::vector<CalibrationEntry> &entries) {
+  std::vector<CacheLine> lines;
+  readLines(path, lines);
+
+  std::string temp = path + ".tmp";
+  FILE *file = fopen(temp.c_str(), "w");
+
+  if (!file) {
+    return false;
+  }
+
+  for (size_t i = 0; i < lines.size(); i++) {
+    if (lines[i].port == port) {
+      continue;
+    }
+
+    const CalibrationEntry &entry = lines[i].entry;
+    fprintf(file, "%s %u %s %u %u %u %u %d\n", lines[i].port.c_str(),
+            entry.address, entry.identity.c_str(), entry.para.u_compensateK0,
+            entry.para.u_compensateB0, entry.para.u_compensateK1,
+            entry.para.u_compensateB1, entry.para.bias);
+  }
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    const CalibrationEntry &entry = entries[i];
+    fprintf(file, "%s %u %s %u %u %u %u %d\n", port.c_str(), entry.address,
+            entry.identity.c_str(), entry.para.u_compensateK0,
+            entry.para.u_compensateB0, entry.para.u_compensateK1,
+            entry.para.u_compensateB1, entry.para.bias);
+  }
+
+  bool ok = fflush(file) == 0;
+  ok = fclose(file) == 0 && ok;
+
+  if (!ok) {
+    remove(temp.c_str());
+    return false;
+  }
+
+#if defined(_WIN32)
+  //Windows下目标文件存在时rename失败
+  remove(path.c_str());
+#endif
+
+  if (rename(temp.c_str(), path.c_str()) != 0) {
+    remove(temp.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+bool sameCalibration(const std::vector<CalibrationEntry> &a,
+                     const std::vector<CalibrationEntry> &b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < a.size(); i++) {
+    bool found = false;
+
+    for (size_t j = 0; j < b.size() && !found; j++) {
+      found = a[i].address == b[j].address &&
+              a[i].identity == b[j].identity &&
+              a[i].para.u_compensateK0 == b[j].para.u_compensateK0 &&
+              a[i].para.u_compensateB0 == b[j].para.u_compensateB0 &&
+              a[i].para.u_compensateK1 == b[j].para.u_compensateK1 &&
+              a[i].para.u_compensateB1 == b[j].para.u_compensateB1 &&
+              a[i].para.bias == b[j].para.bias;
+    }
+
+    if (!found) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace ydlidar
@@ -0,0 +1,175 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+#include "clock_filter.h"
+#include <math.h>
+#include <algorithm>
+
+namespace ydlidar {
+
+ClockFilter::ClockFilter() {
+  reset();
+}
+
+void ClockFilter::reset() {
+  restart();
+  last_output_ = 0;
+  period_ = 0;
+}
+
+void ClockFilter::restart() {
+  base_ = 0;
+  head_ = 0;
+  count_ = 0;
+  rejects_ = 0;
+  last_index_ = 0;
+  slope_ = 0;
+  intercept_ = 0;
+}
+
+uint64_t ClockFilter::update(uint64_t stamp) {
+  if (!count_) {
+    base_ = stamp;
+    index_[0] = 0;
+    stamp_[0] = 0;
+    head_ = 1;
+    count_ = 1;
+    last_index_ = 0;
+    return output(stamp);
+  }
+
+  double t = static_cast<double>(static_cast<int64_t>(stamp - base_));
+  int64_t index = last_index_ + 1;
+
+  if (count_ >= 2 && slope_ > 0) {
+    //按周期数推算序号, 中间丢包时序号跳过; 抖动只会推迟到达, 最多提前1/3周期
+    index = static_cast<int64_t>(floor((t - intercept_) / slope_ + 1.0 / 3));
+    bool forced = index <= last_index_;
+
+    if (forced) {
+      index = last_index_ + 1;
+    }
+
+    double predicted = predict(index);
+
+    //预热阶段要求序号连续, 避免锁定到周期的几分之一
+    if (!locked() && index != last_index_ + 1) {
+      restart();
+      return update(stamp);
+    }
+
+    if (fabs(t - predicted) > slope_ / 3) {
+      //预热阶段的样本含丢包或积压, 从当前样本重新开始
+      if (!locked() || ++rejects_ > MaxRejects) {
+        restart();
+        return update(stamp);
+      }
+
+      //迟到的数据包取所在周期的时间; 序号已被占用的积压数据包取到达时间
+      if (!forced) {
+        last_index_ = index;
+      }
+
+      return output(base_ + static_cast<uint64_t>(llround(std::min(t, predicted))));
+    }
+  }
+
+  rejects_ = 0;
+  index_[head_] = index;
+  stamp_[head_] = t;
+  head_ = (head_ + 1) % WindowSize;
+
+  if (count_ < WindowSize) {
+    count_++;
+  }
+
+  last_index_ = index;
+  fit();
+
+  if (!locked()) {
+    return output(stamp);
+  }
+
+  period_ = static_cast<uint64_t>(llround(slope_));
+
+  return output(base_ + static_cast<uint64_t>(llround(predict(index))));
+}
+
+uint64_t ClockFilter::output(uint64_t stamp) {
+  if (stamp < last_output_) {
+    stamp = last_output_;
+  }
+
+  last_output_ = stamp;
+  return stamp;
+}
+
+uint64_t ClockFilter::period() const {
+  return period_;
+}
+
+void ClockFilter::fit() {
+  double mean_index = 0;
+  double mean_stamp = 0;
+
+  for (int i = 0; i < count_; i++) {
+    mean_index += index_[i];
+    mean_stamp += stamp_[i];
+  }
+
+  mean_index /= count_;
+  mean_stamp /= count_;
+
+  //中心化后计算, 避免序号较大时损失精度
+  double sxx = 0;
+  double sxy = 0;
+
+  for (int i = 0; i < count_; i++) {
+    double di = index_[i] - mean_index;
+    sxx += di * di;
+    sxy += di * (stamp_[i] - mean_stamp);
+  }
+
+  if (sxx <= 0 || sxy <= 0) {
+    return;
+  }
+
+  slope_ = sxy / sxx;
+  intercept_ = mean_stamp - slope_ * mean_index;
+}
+
+double ClockFilter::predict(int64_t index) const {
+  return intercept_ + slope_ * index;
+}
+
+} // namespace ydlidar
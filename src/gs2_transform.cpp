@@ -0,0 +1,301 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+#include "gs2_transform.h"
+#include <math.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define GS2_TRANSFORM_HAS_AVX2
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GS2_TRANSFORM_HAS_SSE2
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GS2_TRANSFORM_HAS_NEON
+#endif
+
+namespace ydlidar {
+
+namespace {
+
+const float kPx = static_cast<float>(Angle_Px);
+const float kHalfPi = 1.57079632679f;
+const float kRadToDeg = 57.2957795131f;
+const uint16_t kDistanceMask = 0x01ff;
+
+// atan(a), a in [0, 1], Abramowitz & Stegun 4.4.49, |error| < 1e-5 rad
+const float kAtan1 = 0.9998660f;
+const float kAtan3 = -0.3302995f;
+const float kAtan5 = 0.1801410f;
+const float kAtan7 = -0.0851330f;
+const float kAtan9 = 0.0208351f;
+
+void transformScalar(const GS2PackageNode *samples,
+                     const GS2TransformTable &table,
+                     float *theta, float *dist) {
+  for (int i = 0; i < PackageSampleMaxLngth_GS; i++) {
+    uint16_t d = samples[i].PakageSampleDistance;
+
+    if (d == 0) {
+      theta[i] = 0;
+      dist[i] = 0;
+      continue;
+    }
+
+    double x = d;
+    double y = (d - Angle_Px) * table.k[i] + table.c[i];
+    double angle = atan(y / x) * 180 / M_PI;
+
+    if (angle < 0) {
+      angle += 360;
+    }
+
+    theta[i] = static_cast<float>(angle);
+    dist[i] = static_cast<float>(sqrt(x * x + y * y));
+  }
+}
+
+#if defined(GS2_TRANSFORM_HAS_SSE2)
+void transformSSE2(const GS2PackageNode *samples,
+                   const GS2TransformTable &table,
+                   float *theta, float *dist) {
+  const uint8_t *raw = reinterpret_cast<const uint8_t *>(samples);
+  const __m128i mask = _mm_set1_epi32(kDistanceMask);
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 zero = _mm_setzero_ps();
+
+  for (int i = 0; i < PackageSampleMaxLngth_GS; i += 4) {
+    __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(raw + 2 * i));
+    v = _mm_and_si128(_mm_unpacklo_epi16(v, _mm_setzero_si128()), mask);
+    __m128 x = _mm_cvtepi32_ps(v);
+    __m128 y = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(x, _mm_set1_ps(kPx)),
+                                     _mm_loadu_ps(table.k + i)),
+                          _mm_loadu_ps(table.c + i));
+    __m128 r = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)));
+
+    // atan(y / x), x > 0: reduce to [0, 1] and restore octant and sign
+    __m128 ay = _mm_andnot_ps(sign, y);
+    __m128 a = _mm_div_ps(_mm_min_ps(ay, x), _mm_max_ps(ay, x));
+    __m128 s = _mm_mul_ps(a, a);
+    __m128 p = _mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(kAtan9)), _mm_set1_ps(kAtan7));
+    p = _mm_add_ps(_mm_mul_ps(s, p), _mm_set1_ps(kAtan5));
+    p = _mm_add_ps(_mm_mul_ps(s, p), _mm_set1_ps(kAtan3));
+    p = _mm_add_ps(_mm_mul_ps(s, p), _mm_set1_ps(kAtan1));
+    p = _mm_mul_ps(a, p);
+    __m128 octant = _mm_cmpgt_ps(ay, x);
+    p = _mm_or_ps(_mm_and_ps(octant, _mm_sub_ps(_mm_set1_ps(kHalfPi), p)),
+                  _mm_andnot_ps(octant, p));
+    p = _mm_mul_ps(_mm_or_ps(p, _mm_and_ps(sign, y)), _mm_set1_ps(kRadToDeg));
+    p = _mm_add_ps(p, _mm_and_ps(_mm_cmplt_ps(p, zero), _mm_set1_ps(360.f)));
+
+    __m128 valid = _mm_cmpgt_ps(x, zero);
+    _mm_storeu_ps(theta + i, _mm_and_ps(valid, p));
+    _mm_storeu_ps(dist + i, _mm_and_ps(valid, r));
+  }
+}
+#endif
+
+#if defined(GS2_TRANSFORM_HAS_AVX2)
+__attribute__((target("avx2")))
+void transformAVX2(const GS2PackageNode *samples,
+                   const GS2TransformTable &table,
+                   float *theta, float *dist) {
+  const uint8_t *raw = reinterpret_cast<const uint8_t *>(samples);
+  const __m256i mask = _mm256_set1_epi32(kDistanceMask);
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 zero = _mm256_setzero_ps();
+
+  for (int i = 0; i < PackageSampleMaxLngth_GS; i += 8) {
+    __m256i v = _mm256_cvtepu16_epi32(
+                  _mm_loadu_si128(reinterpret_cast<const __m128i *>(raw + 2 * i)));
+    __m256 x = _mm256_cvtepi32_ps(_mm256_and_si256(v, mask));
+    __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(x, _mm256_set1_ps(kPx)),
+                                           _mm256_loadu_ps(table.k + i)),
+                             _mm256_loadu_ps(table.c + i));
+    __m256 r = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(x, x),
+                                            _mm256_mul_ps(y, y)));
+
+    __m256 ay = _mm256_andnot_ps(sign, y);
+    __m256 a = _mm256_div_ps(_mm256_min_ps(ay, x), _mm256_max_ps(ay, x));
+    __m256 s = _mm256_mul_ps(a, a);
+    __m256 p = _mm256_add_ps(_mm256_mul_ps(s, _mm256_set1_ps(kAtan9)),
+                             _mm256_set1_ps(kAtan7));
+    p = _mm256_add_ps(_mm256_mul_ps(s, p), _mm256_set1_ps(kAtan5));
+    p = _mm256_add_ps(_mm256_mul_ps(s, p), _mm256_set1_ps(kAtan3));
+    p = _mm256_add_ps(_mm256_mul_ps(s, p), _mm256_set1_ps(kAtan1));
+    p = _mm256_mul_ps(a, p);
+    p = _mm256_blendv_ps(p, _mm256_sub_ps(_mm256_set1_ps(kHalfPi), p),
+                         _mm256_cmp_ps(ay, x, _CMP_GT_OQ));
+    p = _mm256_mul_ps(_mm256_or_ps(p, _mm256_and_ps(sign, y)),
+                      _mm256_set1_ps(kRadToDeg));
+    p = _mm256_add_ps(p, _mm256_and_ps(_mm256_cmp_ps(p, zero, _CMP_LT_OQ),
+                                       _mm256_set1_ps(360.f)));
+
+    __m256 valid = _mm256_cmp_ps(x, zero, _CMP_GT_OQ);
+    _mm256_storeu_ps(theta + i, _mm256_and_ps(valid, p));
+    _mm256_storeu_ps(dist + i, _mm256_and_ps(valid, r));
+  }
+}
+#endif
+
+#if defined(GS2_TRANSFORM_HAS_NEON)
+void transformNEON(const GS2PackageNode *samples,
+                   const GS2TransformTable &table,
+                   float *theta, float *dist) {
+  const uint8_t *raw = reinterpret_cast<const uint8_t *>(samples);
+  const uint32x4_t mask = vdupq_n_u32(kDistanceMask);
+  const float32x4_t zero = vdupq_n_f32(0.f);
+
+  for (int i = 0; i < PackageSampleMaxLngth_GS; i += 4) {
+    uint16x4_t v = vld1_u16(reinterpret_cast<const uint16_t *>(raw + 2 * i));
+    float32x4_t x = vcvtq_f32_u32(vandq_u32(vmovl_u16(v), mask));
+    float32x4_t y = vfmaq_f32(vld1q_f32(table.c + i),
+                              vsubq_f32(x, vdupq_n_f32(kPx)),
+                              vld1q_f32(table.k + i));
+    float32x4_t r = vsqrtq_f32(vfmaq_f32(vmulq_f32(y, y), x, x));
+
+    float32x4_t ay = vabsq_f32(y);
+    float32x4_t a = vdivq_f32(vminq_f32(ay, x), vmaxq_f32(ay, x));
+    float32x4_t s = vmulq_f32(a, a);
+    float32x4_t p = vfmaq_f32(vdupq_n_f32(kAtan7), s, vdupq_n_f32(kAtan9));
+    p = vfmaq_f32(vdupq_n_f32(kAtan5), s, p);
+    p = vfmaq_f32(vdupq_n_f32(kAtan3), s, p);
+    p = vfmaq_f32(vdupq_n_f32(kAtan1), s, p);
+    p = vmulq_f32(a, p);
+    p = vbslq_f32(vcgtq_f32(ay, x), vsubq_f32(vdupq_n_f32(kHalfPi), p), p);
+    p = vbslq_f32(vcltq_f32(y, zero), vnegq_f32(p), p);
+    p = vmulq_f32(p, vdupq_n_f32(kRadToDeg));
+    p = vbslq_f32(vcltq_f32(p, zero), vaddq_f32(p, vdupq_n_f32(360.f)), p);
+
+    uint32x4_t valid = vcgtq_f32(x, zero);
+    vst1q_f32(theta + i, vbslq_f32(valid, p, zero));
+    vst1q_f32(dist + i, vbslq_f32(valid, r, zero));
+  }
+}
+#endif
+
+TransformISA selectTransformISA() {
+#if defined(GS2_TRANSFORM_HAS_AVX2)
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx2")) {
+    return TRANSFORM_ISA_AVX2;
+  }
+
+#endif
+#if defined(GS2_TRANSFORM_HAS_SSE2)
+  return TRANSFORM_ISA_SSE2;
+#elif defined(GS2_TRANSFORM_HAS_NEON)
+  return TRANSFORM_ISA_NEON;
+#else
+  return TRANSFORM_ISA_SCALAR;
+#endif
+}
+
+}
+
+BatchTransformFunc getBatchTransform(TransformISA isa) {
+  switch (isa) {
+    case TRANSFORM_ISA_SCALAR:
+      return transformScalar;
+#if defined(GS2_TRANSFORM_HAS_SSE2)
+
+    case TRANSFORM_ISA_SSE2:
+      return transformSSE2;
+#endif
+#if defined(GS2_TRANSFORM_HAS_AVX2)
+
+    case TRANSFORM_ISA_AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") ? transformAVX2 : NULL;
+#endif
+#if defined(GS2_TRANSFORM_HAS_NEON)
+
+    case TRANSFORM_ISA_NEON:
+      return transformNEON;
+#endif
+
+    default:
+      return NULL;
+  }
+}
+
+TransformISA getBatchTransformISA() {
+  static const TransformISA isa = selectTransformISA();
+  return isa;
+}
+
+void batchTransform(const GS2PackageNode *samples,
+                    const GS2TransformTable &table,
+                    float *theta, float *dist) {
+  static const BatchTransformFunc func = getBatchTransform(
+        getBatchTransformISA());
+  func(samples, table, theta, dist);
+}
+
+void cartesianTransform(const GS2PackageNode *samples,
+                        const GS2TransformTable &table,
+                        float *x, float *y) {
+  for (int i = 0; i < PackageSampleMaxLngth_GS; i++) {
+    float d = samples[i].PakageSampleDistance;
+    float valid = d > 0 ? 1.f : 0.f;
+    x[i] = d;
+    y[i] = ((d - kPx) * table.k[i] + table.c[i]) * valid;
+  }
+}
+
+const char *transformISAToString(TransformISA isa) {
+  switch (isa) {
+    case TRANSFORM_ISA_SCALAR:
+      return "scalar";
+
+    case TRANSFORM_ISA_SSE2:
+      return "sse2";
+
+    case TRANSFORM_ISA_AVX2:
+      return "avx2";
+
+    case TRANSFORM_ISA_NEON:
+      return "neon";
+
+    default:
+      return "unknown";
+  }
+}
+
+}// namespace ydlidar
@@ -1,34 +1,44 @@
-#if defined(_WIN32)
-#include "timer.h"
-#include <mmsystem.h>
-#pragma comment(lib, "Winmm.lib")
-
-namespace impl {
-
-static LARGE_INTEGER _current_freq;
-
-void HPtimer_reset() {
-  BOOL ans = QueryPerformanceFrequency(&_current_freq);
-  _current_freq.QuadPart /= 1000;
-}
-
-uint32_t getHDTimer() {
-  LARGE_INTEGER current;
-  QueryPerformanceCounter(&current);
-
-  return (uint32_t)(current.QuadPart / (_current_freq.QuadPart));
-}
-
-uint64_t getCurrentTime() {
-  FILETIME		t;
-  GetSystemTimeAsFileTime(&t);
-  return ((((uint64_t)t.dwHighDateTime) << 32) | ((uint64_t)t.dwLowDateTime)) * 100;
-}
-
-
-BEGIN_STATIC_CODE(timer_cailb) {
-  HPtimer_reset();
-} END_STATIC_CODE(timer_cailb)
-
-}
-#endif
+#if defined(_WIN32)
+#include "timer.h"
+#include <mmsystem.h>
+#pragma comment(lib, "Winmm.lib")
+
+namespace impl {
+
+static LARGE_INTEGER _current_freq;
+
+void HPtimer_reset() {
+  BOOL ans = QueryPerformanceFrequency(&_current_freq);
+  _current_freq.QuadPart /= 1000;
+}
+
+uint32_t getHDTimer() {
+  LARGE_INTEGER current;
+  QueryPerformanceCounter(&current);
+
+  return (uint32_t)(current.QuadPart / (_current_freq.QuadPart));
+}
+
+uint64_t getCurrentTime() {
+  FILETIME		t;
+  GetSystemTimeAsFileTime(&t);
+  return ((((uint64_t)t.dwHighDateTime) << 32) | ((uint64_t)t.dwLowDateTime)) * 100;
+}
+
+uint64_t getMonotonicTime() {
+  LARGE_INTEGER current;
+  QueryPerformanceCounter(&current);
+
+  //_current_freq为每毫秒计数
+  uint64_t ms = current.QuadPart / _current_freq.QuadPart;
+  uint64_t rest = current.QuadPart % _current_freq.QuadPart;
+  return ms * 1000000 + rest * 1000000 / _current_freq.QuadPart;
+}
+
+
+BEGIN_STATIC_CODE(timer_cailb) {
+  HPtimer_reset();
+} END_STATIC_CODE(timer_cailb)
+
+}
+#endif
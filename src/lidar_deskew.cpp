@@ -0,0 +1,353 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+#include "lidar_deskew.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIDAR_DESKEW_HAS_SSE2
+#endif
+
+namespace ydlidar {
+
+namespace {
+
+const float kPi = 3.14159265359f;
+const float kTwoPi = 6.28318530718f;
+const float kHalfPi = 1.57079632679f;
+
+// atan(a), a in [0, 1], Abramowitz & Stegun 4.4.49, |error| < 1e-5 rad
+const float kAtan1 = 0.9998660f;
+const float kAtan3 = -0.3302995f;
+const float kAtan5 = 0.1801410f;
+const float kAtan7 = -0.0851330f;
+const float kAtan9 = 0.0208351f;
+
+// sin/cos Taylor coefficients, |x| <= pi / 2, |error| < 1e-6
+const float kSin3 = -1.0f / 6;
+const float kSin5 = 1.0f / 120;
+const float kSin7 = -1.0f / 5040;
+const float kSin9 = 1.0f / 362880;
+const float kCos2 = -1.0f / 2;
+const float kCos4 = 1.0f / 24;
+const float kCos6 = -1.0f / 720;
+const float kCos8 = 1.0f / 40320;
+const float kCos10 = -1.0f / 3628800;
+
+double normalizeAngle(double angle) {
+  return atan2(sin(angle), cos(angle));
+}
+
+/// 按字节地址读写, 不要求对齐
+inline float loadFloat(const uint8_t *p) {
+  float v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline void storeFloat(uint8_t *p, float v) {
+  memcpy(p, &v, sizeof(v));
+}
+
+void deskewScalar(float &angle, float &range, float t,
+                  const DeskewMotion &motion) {
+  if (range <= 0) {
+    return;
+  }
+
+  float half = 0.5f * motion.wz * t;
+  float sinc = half != 0 ? sinf(half) / half : 1.0f;
+  float ch = cosf(half) * sinc * t;
+  float sh = sinf(half) * sinc * t;
+  float dx = motion.vx * ch - motion.vy * sh;
+  float dy = motion.vx * sh + motion.vy * ch;
+  float phi = angle + 2 * half;
+  float c = cosf(phi);
+  float s = sinf(phi);
+  float qx = range + dx * c + dy * s;
+  float qy = dy * c - dx * s;
+
+  range = sqrtf(qx * qx + qy * qy);
+  angle = phi + atan2f(qy, qx);
+
+  if (angle > kPi) {
+    angle -= kTwoPi;
+  } else if (angle < -kPi) {
+    angle += kTwoPi;
+  }
+}
+
+/// 读取一个点校正后写回
+void deskewPoint(uint8_t *angle, uint8_t *range, float t,
+                 const DeskewMotion &motion) {
+  float a = loadFloat(angle);
+  float r = loadFloat(range);
+  deskewScalar(a, r, t, motion);
+  storeFloat(angle, a);
+  storeFloat(range, r);
+}
+
+#if defined(LIDAR_DESKEW_HAS_SSE2)
+inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// sin/cos, |x| <= pi / 2
+inline void sinCosHalfPi(__m128 x, __m128 &s, __m128 &c) {
+  __m128 x2 = _mm_mul_ps(x, x);
+  __m128 p = _mm_add_ps(_mm_mul_ps(x2, _mm_set1_ps(kSin9)), _mm_set1_ps(kSin7));
+  p = _mm_add_ps(_mm_mul_ps(x2, p), _mm_set1_ps(kSin5));
+  p = _mm_add_ps(_mm_mul_ps(x2, p), _mm_set1_ps(kSin3));
+  p = _mm_add_ps(_mm_mul_ps(x2, p), _mm_set1_ps(1.0f));
+  s = _mm_mul_ps(x, p);
+
+  p = _mm_add_ps(_mm_mul_ps(x2, _mm_set1_ps(kCos10)), _mm_set1_ps(kCos8));
+  p = _mm_add_ps(_mm_mul_ps(x2, p), _mm_set1_ps(kCos6));
+  p = _mm_add_ps(_mm_mul_ps(x2, p), _mm_set1_ps(kCos4));
+  p = _mm_add_ps(_mm_mul_ps(x2, p), _mm_set1_ps(kCos2));
+  c = _mm_add_ps(_mm_mul_ps(x2, p), _mm_set1_ps(1.0f));
+}
+
+// wrap to [-pi, pi], then sin(x) = sin(pi - x), cos(x) = -cos(pi - x)
+inline void sinCos(__m128 x, __m128 &s, __m128 &c) {
+  __m128i k = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.0f / kTwoPi)));
+  x = _mm_sub_ps(x, _mm_mul_ps(_mm_cvtepi32_ps(k), _mm_set1_ps(kTwoPi)));
+
+  __m128 sign = _mm_set1_ps(-0.0f);
+  __m128 xsign = _mm_and_ps(sign, x);
+  __m128 upper = _mm_cmpgt_ps(_mm_andnot_ps(sign, x), _mm_set1_ps(kHalfPi));
+  __m128 reflected = _mm_sub_ps(_mm_or_ps(_mm_set1_ps(kPi), xsign), x);
+  sinCosHalfPi(select(upper, reflected, x), s, c);
+  c = _mm_xor_ps(c, _mm_and_ps(upper, sign));
+}
+
+inline __m128 atan2(__m128 y, __m128 x) {
+  __m128 sign = _mm_set1_ps(-0.0f);
+  __m128 ax = _mm_andnot_ps(sign, x);
+  __m128 ay = _mm_andnot_ps(sign, y);
+  __m128 a = _mm_div_ps(_mm_min_ps(ax, ay),
+                        _mm_max_ps(_mm_max_ps(ax, ay), _mm_set1_ps(1e-30f)));
+  __m128 s = _mm_mul_ps(a, a);
+  __m128 p = _mm_add_ps(_mm_mul_ps(s, _mm_set1_ps(kAtan9)), _mm_set1_ps(kAtan7));
+  p = _mm_add_ps(_mm_mul_ps(s, p), _mm_set1_ps(kAtan5));
+  p = _mm_add_ps(_mm_mul_ps(s, p), _mm_set1_ps(kAtan3));
+  p = _mm_add_ps(_mm_mul_ps(s, p), _mm_set1_ps(kAtan1));
+  p = _mm_mul_ps(a, p);
+  p = select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(kHalfPi), p), p);
+  p = select(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(kPi), p), p);
+  return _mm_or_ps(p, _mm_and_ps(sign, y));
+}
+
+void deskewSSE2(uint8_t *angles, uint8_t *ranges, size_t stride,
+                const float *timeOffsets, size_t count,
+                const DeskewMotion &motion) {
+  const __m128 vx = _mm_set1_ps(motion.vx);
+  const __m128 vy = _mm_set1_ps(motion.vy);
+  const __m128 halfW = _mm_set1_ps(0.5f * motion.wz);
+  const __m128 zero = _mm_setzero_ps();
+  float angle[4];
+  float range[4];
+  size_t i = 0;
+
+  for (; i + 4 <= count; i += 4) {
+    for (int k = 0; k < 4; k++) {
+      angle[k] = loadFloat(angles + (i + k) * stride);
+      range[k] = loadFloat(ranges + (i + k) * stride);
+    }
+
+    __m128 a = _mm_loadu_ps(angle);
+    __m128 r = _mm_loadu_ps(range);
+    __m128 t = _mm_loadu_ps(timeOffsets + i);
+    __m128 half = _mm_mul_ps(halfW, t);
+
+    // t * sinc(half) * (cos(half), sin(half)), |half| is small
+    __m128 sh, ch;
+    sinCosHalfPi(half, sh, ch);
+    __m128 h2 = _mm_mul_ps(half, half);
+    __m128 sinc = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(h2, _mm_set1_ps(kSin3)));
+    __m128 scale = _mm_mul_ps(t, sinc);
+    ch = _mm_mul_ps(ch, scale);
+    sh = _mm_mul_ps(sh, scale);
+    __m128 dx = _mm_sub_ps(_mm_mul_ps(vx, ch), _mm_mul_ps(vy, sh));
+    __m128 dy = _mm_add_ps(_mm_mul_ps(vx, sh), _mm_mul_ps(vy, ch));
+
+    __m128 phi = _mm_add_ps(a, _mm_add_ps(half, half));
+    __m128 s, c;
+    sinCos(phi, s, c);
+    __m128 qx = _mm_add_ps(r, _mm_add_ps(_mm_mul_ps(dx, c), _mm_mul_ps(dy, s)));
+    __m128 qy = _mm_sub_ps(_mm_mul_ps(dy, c), _mm_mul_ps(dx, s));
+
+    __m128 nr = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)));
+    __m128 na = _mm_add_ps(phi, atan2(qy, qx));
+    na = _mm_sub_ps(na, _mm_and_ps(_mm_cmpgt_ps(na, _mm_set1_ps(kPi)),
+                                   _mm_set1_ps(kTwoPi)));
+    na = _mm_add_ps(na, _mm_and_ps(_mm_cmplt_ps(na, _mm_set1_ps(-kPi)),
+                                   _mm_set1_ps(kTwoPi)));
+
+    __m128 valid = _mm_cmpgt_ps(r, zero);
+    _mm_storeu_ps(angle, select(valid, na, a));
+    _mm_storeu_ps(range, select(valid, nr, r));
+
+    for (int k = 0; k < 4; k++) {
+      storeFloat(angles + (i + k) * stride, angle[k]);
+      storeFloat(ranges + (i + k) * stride, range[k]);
+    }
+  }
+
+  for (; i < count; i++) {
+    deskewPoint(angles + i * stride, ranges + i * stride, timeOffsets[i], motion);
+  }
+}
+#endif
+
+}
+
+TwistBuffer::TwistBuffer() : head_(0), count_(0) {
+}
+
+void TwistBuffer::push(const LidarTwist &twist) {
+  ScopedLocker l(lock_);
+
+  if (count_) {
+    const LidarTwist &last = twists_[(head_ + Capacity - 1) % Capacity];
+
+    if (twist.stamp < last.stamp) {
+      count_ = 0;
+    }
+  }
+
+  twists_[head_] = twist;
+  head_ = (head_ + 1) % Capacity;
+
+  if (count_ < Capacity) {
+    count_++;
+  }
+}
+
+void TwistBuffer::clear() {
+  ScopedLocker l(lock_);
+  count_ = 0;
+}
+
+bool TwistBuffer::motion(uint64_t from, uint64_t to,
+                         DeskewMotion &motion) const {
+  ScopedLocker l(lock_);
+
+  if (!count_) {
+    return false;
+  }
+
+  uint64_t mid = from + (to - from) / 2;
+  size_t first = (head_ + Capacity - count_) % Capacity;
+  const LidarTwist &oldest = twists_[first];
+  const LidarTwist &newest = twists_[(head_ + Capacity - 1) % Capacity];
+  const LidarTwist *twist = NULL;
+
+  if (mid <= oldest.stamp) {
+    if (oldest.stamp - mid > MaxExtrapolation) {
+      return false;
+    }
+
+    twist = &oldest;
+  } else if (mid >= newest.stamp) {
+    if (mid - newest.stamp > MaxExtrapolation) {
+      return false;
+    }
+
+    twist = &newest;
+  }
+
+  if (twist) {
+    motion.vx = twist->vx;
+    motion.vy = twist->vy;
+    motion.wz = twist->wz;
+    return true;
+  }
+
+  //时间戳递增, 查找中间时刻前后两个速度线性插值
+  for (size_t n = 1; n < count_; n++) {
+    const LidarTwist &prev = twists_[(first + n - 1) % Capacity];
+    const LidarTwist &next = twists_[(first + n) % Capacity];
+
+    if (next.stamp < mid) {
+      continue;
+    }
+
+    float k = next.stamp > prev.stamp ?
+              float(mid - prev.stamp) / float(next.stamp - prev.stamp) : 1.0f;
+    motion.vx = prev.vx + (next.vx - prev.vx) * k;
+    motion.vy = prev.vy + (next.vy - prev.vy) * k;
+    motion.wz = prev.wz + (next.wz - prev.wz) * k;
+    return true;
+  }
+
+  return false;
+}
+
+void deskewMotionFromPoses(const LidarPose2D &ref, const LidarPose2D &end,
+                           double duration, DeskewMotion &motion) {
+  double dtheta = normalizeAngle(end.theta - ref.theta);
+  double c = cos(ref.theta);
+  double s = sin(ref.theta);
+  double dx = c * (end.x - ref.x) + s * (end.y - ref.y);
+  double dy = c * (end.y - ref.y) - s * (end.x - ref.x);
+
+  //d = R(dθ / 2) * v * T * sinc(dθ / 2), 求v
+  double half = dtheta / 2;
+  double scale = duration * (half != 0 ? sin(half) / half : 1.0);
+  double ch = cos(half);
+  double sh = sin(half);
+  motion.vx = static_cast<float>((ch * dx + sh * dy) / scale);
+  motion.vy = static_cast<float>((ch * dy - sh * dx) / scale);
+  motion.wz = static_cast<float>(dtheta / duration);
+}
+
+void deskewPoints(void *angles, void *ranges, size_t stride,
+                  const float *timeOffsets, size_t count,
+                  const DeskewMotion &motion) {
+  uint8_t *angle = static_cast<uint8_t *>(angles);
+  uint8_t *range = static_cast<uint8_t *>(ranges);
+#if defined(LIDAR_DESKEW_HAS_SSE2)
+  deskewSSE2(angle, range, stride, timeOffsets, count, motion);
+#else
+
+  for (size_t i = 0; i < count; i++) {
+    deskewPoint(angle + i * stride, range + i * stride, timeOffsets[i], motion);
+  }
+
+#endif
+}
+
+} // namespace ydlidar
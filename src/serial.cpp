@@ -98,6 +98,18 @@ int Serial::waitfordata(size_t data_count, uint32_t timeout,
   return pimpl_->waitfordata(data_count, timeout, returned_size);
 }
 
+void Serial::cancelWait() {
+  pimpl_->cancelWait();
+}
+
+void Serial::clearCancelWait() {
+  pimpl_->clearCancelWait();
+}
+
+bool Serial::getWaitSurplus(uint64_t &ns) const {
+  return pimpl_->getWaitSurplus(ns);
+}
+
 size_t Serial::writeData(const uint8_t *data, size_t size) {
   return write(data, size);
 }
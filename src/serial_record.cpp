@@ -0,0 +1,299 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+#include "serial_record.h"
+#include "common.h"
+
+namespace ydlidar {
+
+SerialRecorder::SerialRecorder() : file_(NULL) {
+}
+
+SerialRecorder::~SerialRecorder() {
+  close();
+}
+
+bool SerialRecorder::open(const std::string &path, uint32_t baudrate) {
+  ScopedLocker l(lock_);
+
+  if (file_) {
+    fclose(file_);
+  }
+
+  file_ = fopen(path.c_str(), "wb");
+
+  if (!file_) {
+    return false;
+  }
+
+  SerialRecordHeader header;
+  memcpy(header.magic, SERIAL_RECORD_MAGIC, sizeof(header.magic));
+  header.version = SERIAL_RECORD_VERSION;
+  header.baudrate = baudrate;
+
+  if (fwrite(&header, sizeof(header), 1, file_) != 1) {
+    fclose(file_);
+    file_ = NULL;
+    return false;
+  }
+
+  return true;
+}
+
+void SerialRecorder::close() {
+  ScopedLocker l(lock_);
+
+  if (file_) {
+    fclose(file_);
+    file_ = NULL;
+  }
+}
+
+bool SerialRecorder::isOpen() const {
+  return file_ != NULL;
+}
+
+void SerialRecorder::write(const uint8_t *data, size_t size) {
+  if (!file_ || !size) {
+    return;
+  }
+
+  SerialRecordChunk chunk;
+  chunk.stamp = getMonoTime();
+  ScopedLocker l(lock_);
+
+  while (file_ && size) {
+    chunk.size = std::min<size_t>(size, SERIAL_RECORD_MAX_CHUNK);
+    fwrite(&chunk, sizeof(chunk), 1, file_);
+    fwrite(data, 1, chunk.size, file_);
+    data += chunk.size;
+    size -= chunk.size;
+  }
+}
+
+ReplaySerial::ReplaySerial(const std::string &path, double speed)
+  : serial::Serial(), path_(path), speed_(speed), is_open_(false),
+    loaded_(false), baudrate_(0), next_chunk_(0), read_pos_(0), end_pos_(0),
+    play_start_(0), record_start_(0), cancel_(false) {
+}
+
+ReplaySerial::~ReplaySerial() {
+}
+
+bool ReplaySerial::load() {
+  FILE *file = fopen(path_.c_str(), "rb");
+
+  if (!file) {
+    return false;
+  }
+
+  SerialRecordHeader header;
+
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      memcmp(header.magic, SERIAL_RECORD_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != SERIAL_RECORD_VERSION) {
+    fclose(file);
+    return false;
+  }
+
+  baudrate_ = header.baudrate;
+  SerialRecordChunk chunk;
+
+  while (fread(&chunk, sizeof(chunk), 1, file) == 1) {
+    if (chunk.size > SERIAL_RECORD_MAX_CHUNK) {
+      fclose(file);
+      data_.clear();
+      chunks_.clear();
+      offsets_.clear();
+      return false;
+    }
+
+    size_t offset = data_.size();
+    data_.resize(offset + chunk.size);
+
+    if (fread(&data_[offset], 1, chunk.size, file) != chunk.size) {
+      //丢弃不完整的最后一块
+      data_.resize(offset);
+      break;
+    }
+
+    chunks_.push_back(chunk);
+    offsets_.push_back(offset);
+  }
+
+  fclose(file);
+  loaded_ = true;
+  return true;
+}
+
+bool ReplaySerial::open() {
+  ScopedLocker l(lock_);
+
+  if (!loaded_ && !load()) {
+    return false;
+  }
+
+  //重新打开时从下一个数据块继续回放
+  play_start_ = getMonoTime();
+  record_start_ = next_chunk_ < chunks_.size() ? chunks_[next_chunk_].stamp : 0;
+  is_open_ = true;
+  return true;
+}
+
+bool ReplaySerial::isOpen() {
+  return is_open_;
+}
+
+void ReplaySerial::closePort() {
+  is_open_ = false;
+}
+
+size_t ReplaySerial::release() {
+  if (speed_ > 0) {
+    uint64_t elapsed = (getMonoTime() - play_start_) * speed_;
+
+    while (next_chunk_ < chunks_.size() &&
+           chunks_[next_chunk_].stamp - record_start_ <= elapsed) {
+      end_pos_ = offsets_[next_chunk_] + chunks_[next_chunk_].size;
+      next_chunk_++;
+    }
+  }
+
+  return end_pos_ - read_pos_;
+}
+
+size_t ReplaySerial::available() {
+  if (!is_open_) {
+    return 0;
+  }
+
+  ScopedLocker l(lock_);
+  return release();
+}
+
+int ReplaySerial::waitfordata(size_t data_count, uint32_t timeout,
+                              size_t *returned_size) {
+  size_t length = 0;
+
+  if (returned_size == NULL) {
+    returned_size = &length;
+  }
+
+  uint32_t startTs = getms();
+  *returned_size = 0;
+
+  while (is_open_) {
+    {
+      ScopedLocker l(lock_);
+      *returned_size = release();
+
+      //尽快回放时连续提供数据块, 直到满足要求
+      while (speed_ <= 0 && *returned_size < data_count &&
+             next_chunk_ < chunks_.size()) {
+        end_pos_ = offsets_[next_chunk_] + chunks_[next_chunk_].size;
+        next_chunk_++;
+        *returned_size = end_pos_ - read_pos_;
+      }
+    }
+
+    if (*returned_size >= data_count) {
+      return 0;
+    }
+
+    if (cancel_.exchange(false) || getms() - startTs >= timeout) {
+      return -1;
+    }
+
+    delay(1);
+  }
+
+  return -2;
+}
+
+void ReplaySerial::cancelWait() {
+  cancel_.store(true);
+}
+
+void ReplaySerial::clearCancelWait() {
+  cancel_.store(false);
+}
+
+bool ReplaySerial::getWaitSurplus(uint64_t &ns) const {
+  ns = 0;
+  return false;
+}
+
+size_t ReplaySerial::readData(uint8_t *data, size_t size) {
+  if (!is_open_) {
+    return 0;
+  }
+
+  ScopedLocker l(lock_);
+  size_t count = release();
+
+  if (count > size) {
+    count = size;
+  }
+
+  if (count) {
+    memcpy(data, &data_[read_pos_], count);
+    read_pos_ += count;
+  }
+
+  return count;
+}
+
+size_t ReplaySerial::writeData(const uint8_t *data, size_t size) {
+  (void)data;
+  return is_open_ ? size : 0;
+}
+
+void ReplaySerial::flush() {
+}
+
+bool ReplaySerial::setDTR(bool level) {
+  (void)level;
+  return is_open_;
+}
+
+int ReplaySerial::getByteTime() {
+  //8N1: 10 bit
+  return baudrate_ ? 10 * 1000000000LL / baudrate_ : 0;
+}
+
+bool ReplaySerial::eof() {
+  ScopedLocker l(lock_);
+  return next_chunk_ >= chunks_.size() && read_pos_ == end_pos_;
+}
+
+}// namespace ydlidar
@@ -38,8 +38,26 @@ using namespace impl;
 
 namespace ydlidar {
 
+namespace {
+
+/// 以十六进制输出调试日志, 超出单条日志长度的部分截断
+void logHex(const char *prefix, const uint8_t *data, size_t size) {
+    char text[200];
+    int len = snprintf(text, sizeof(text), "%s", prefix);
+
+    for (size_t i = 0; i < size && len + 3 < (int)sizeof(text); i++) {
+        len += snprintf(text + len, sizeof(text) - len, "%02X", data[i]);
+    }
+
+    YDLIDAR_LOG(LOG_LEVEL_DEBUG, "%s", text);
+}
+
+}
+
 YDlidarDriver::YDlidarDriver():
-    _serial(NULL) {
+    _serial(NULL),
+    external_serial(false),
+    lossless_queue(false) {
     isConnected         = false;
     isScanning          = false;
     //串口配置参数
@@ -48,7 +66,8 @@ YDlidarDriver::YDlidarDriver():
     isAutoconnting      = false;
     m_baudrate          = 230400;
     isSupportMotorDtrCtrl  = true;
-    scan_node_count     = 0;
+    scan_sequence       = 0;
+    scan_clock_offset   = 0;
     sample_rate         = 5000;
     m_PointTime         = 1e9 / 5000;
     trans_delay         = 0;
@@ -69,11 +88,20 @@ YDlidarDriver::YDlidarDriver():
     LastSampleAngleCal  = 0;
     CheckSumResult      = true;
     Valu8Tou16          = 0;
-    package_Sample_Num  = 0;
     moduleNum           = 0;
     frameNum            = 0;
     isPrepareToSend     = false;
-    multi_package.resize(MaximumNumberOfPackages);
+    ready_package       = NULL;
+    reply_type          = 0;
+    reply_expected      = 0;
+    reply_count         = 0;
+
+    for (int i = 0; i < PackageMaxModuleNums; i++) {
+        for (int j = 0; j < PackageFrameSlotNums; j++) {
+            multi_package[i][j].frameNum = -1;
+            multi_package[i][j].moduleNum = 0;
+        }
+    }
 
     last_device_byte    = 0x00;
     asyncRecvPos        = 0;
@@ -84,27 +112,43 @@ YDlidarDriver::YDlidarDriver():
     get_device_health_success = false;
     get_device_info_success = false;
 
-    package_Sample_Index = 0;
     IntervalSampleAngle_LastPackage = 0.0;
-    globalRecvBuffer = new uint8_t[sizeof(gs2_node_package)];
-    scan_node_buf = new node_info[MAX_SCAN_NODES];
+    globalRecvBuffer = new uint8_t[RecvBufferSize];
+    recvHead = 0;
+    recvTail = 0;
+    recvStamp = 0;
+    recvClockOffset = 0;
+    packageStamp = 0;
+    packageLastStamp = 0;
+    packagePointTime = 0;
+    packageIndex = 0xff;
+    packagePolar = true;
+    polar_transform = true;
     package_index = 0;
     has_package_error = false;
-    isValidPoint  =  true;
-    bias[0] = 0;
-    bias[1] = 0;
-    bias[2] = 0;
+    for (int i = 0; i < PackageMaxModuleNums; i++) {
+        d_compensateK0[i] = 0;
+        d_compensateK1[i] = 0;
+        d_compensateB0[i] = 0;
+        d_compensateB1[i] = 0;
+        u_compensateK0[i] = 0;
+        u_compensateK1[i] = 0;
+        u_compensateB0[i] = 0;
+        u_compensateB1[i] = 0;
+        bias[i] = 0;
+        updateCalibrationTable(i);
+    }
+
+    module_mask = 0;
+    calibration_cached = false;
 }
 
 YDlidarDriver::~YDlidarDriver() {
-    {
-        isScanning = false;
-    }
-
     isAutoReconnect = false;
-    _thread.join();
+    disableDataGrabbing();
 
     ScopedLocker lk(_serial_lock);
+    recorder.close();
 
     if (_serial) {
         if (_serial->isOpen()) {
@@ -123,10 +167,6 @@ YDlidarDriver::~YDlidarDriver() {
         globalRecvBuffer = NULL;
     }
 
-    if (scan_node_buf) {
-        delete[] scan_node_buf;
-        scan_node_buf = NULL;
-    }
 }
 
 result_t YDlidarDriver::connect(const char *port_path, uint32_t baudrate) {
@@ -185,10 +225,20 @@ void YDlidarDriver::flushSerial() {
 
     size_t len = _serial->available();
 
-    if (len) {
-        _serial->read(len);
+    //经接收缓冲区丢弃, 保证录制数据与读取顺序一致
+    while (len) {
+        size_t size = std::min<size_t>(len, RecvBufferSize);
+
+        if (IS_FAIL(getData(globalRecvBuffer, size))) {
+            break;
+        }
+
+        len -= size;
     }
 
+    recvHead = 0;
+    recvTail = 0;
+    resetModuleClock();
     delay(20);
 }
 
@@ -214,15 +264,67 @@ void YDlidarDriver::disconnect() {
 
 }
 
+void YDlidarDriver::setSerial(serial::Serial *serial, bool lossless) {
+    ScopedLocker lk(_serial_lock);
+
+    if (_serial) {
+        if (_serial->isOpen()) {
+            _serial->closePort();
+        }
+
+        delete _serial;
+    }
+
+    _serial = serial;
+    external_serial = serial != NULL;
+    lossless_queue = external_serial && lossless;
+}
+
+bool YDlidarDriver::startRecording(const std::string &path,
+                                   uint32_t baudrate) {
+    return recorder.open(path, baudrate);
+}
+
+void YDlidarDriver::stopRecording() {
+    recorder.close();
+}
+
+void YDlidarDriver::setCalibrationCache(const std::string &path) {
+    calibration_cache = path;
+}
+
 
 void YDlidarDriver::disableDataGrabbing() {
     {
         if (isScanning) {
             isScanning = false;
-            _dataEvent.set();
+            scanQueue.notify();
+        }
+    }
+
+    //唤醒等待应答的后台校验线程
+    reply_event.set();
+    _calib_thread.join();
+
+    //唤醒阻塞在串口等待中的采集线程, 线程检查isScanning后自行退出
+    {
+        ScopedLocker l(_serial_lock);
+
+        if (_serial) {
+            _serial->cancelWait();
         }
     }
+
     _thread.join();
+
+    //线程未进入等待时, 清除残留的取消请求
+    {
+        ScopedLocker l(_serial_lock);
+
+        if (_serial) {
+            _serial->clearCancelWait();
+        }
+    }
 }
 
 bool YDlidarDriver::isscanning() const {
@@ -237,37 +339,6 @@ result_t YDlidarDriver::sendCommand(uint8_t cmd,
                                     size_t payloadsize)
 {
     return sendCommand(0x00, cmd, payload, payloadsize);
-//    uint8_t pkt_header[12];
-//    cmd_packet_gs *header = reinterpret_cast<cmd_packet_gs * >(pkt_header);
-//    uint8_t checksum = 0;
-
-//    if (!isConnected) {
-//        return RESULT_FAIL;
-//    }
-
-//    header->syncByte0 = LIDAR_CMD_SYNC_BYTE;
-//    header->syncByte1 = LIDAR_CMD_SYNC_BYTE;
-//    header->syncByte2 = LIDAR_CMD_SYNC_BYTE;
-//    header->syncByte3 = LIDAR_CMD_SYNC_BYTE;
-//    header->address = 0x00;
-//    header->cmd_flag = cmd;
-//    header->size = 0xffff&payloadsize;
-//    sendData(pkt_header, 8) ;
-//    checksum += cmd;
-//    checksum += 0xff&header->size;
-//    checksum += 0xff&(header->size>>8);
-    
-//    if (payloadsize && payload) {
-//      for (size_t pos = 0; pos < payloadsize; ++pos) {
-//        checksum += ((uint8_t *)payload)[pos];
-//      }
-//      uint8_t sizebyte = (uint8_t)(payloadsize);
-//      sendData((const uint8_t *)payload, sizebyte);
-//    }
-    
-//    sendData(&checksum, 1);
-
-//    return RESULT_OK;
 }
 
 result_t YDlidarDriver::sendCommand(uint8_t addr,
@@ -275,37 +346,89 @@ result_t YDlidarDriver::sendCommand(uint8_t addr,
                                     const void *payload,
                                     size_t payloadsize)
 {
-    uint8_t pkt_header[12];
-    cmd_packet_gs *header = reinterpret_cast<cmd_packet_gs * >(pkt_header);
-    uint8_t checksum = 0;
+    LidarCommand command;
+    command.address = addr;
+    command.cmd_flag = cmd;
+    command.payload = payload;
+    command.size = payloadsize;
+
+    return writeCommands(&command, 1);
+}
 
+result_t YDlidarDriver::sendCommands(const LidarCommand *commands, size_t count) {
     if (!isConnected) {
         return RESULT_FAIL;
     }
 
+    ScopedLocker l(_lock);
+    return writeCommands(commands, count);
+}
+
+result_t YDlidarDriver::writeCommands(const LidarCommand *commands,
+                                      size_t count) {
+    if (!isConnected) {
+        return RESULT_FAIL;
+    }
+
+    if (commands == NULL || count == 0) {
+        return RESULT_FAIL;
+    }
+
+    size_t size = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        size += commandFrameSize(commands[i]);
+    }
+
+    //常用命令不带参数, 直接使用栈上缓冲区
+    uint8_t local[64];
+    std::vector<uint8_t> heap;
+    uint8_t *frame = local;
+
+    if (size > sizeof(local)) {
+        heap.resize(size);
+        frame = &heap[0];
+    }
+
+    size_t length = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        length += frameCommand(commands[i], frame + length);
+    }
+
+    return sendData(frame, length);
+}
+
+size_t YDlidarDriver::commandFrameSize(const LidarCommand &command) {
+    size_t payloadsize = command.payload ? (command.size & 0xffff) : 0;
+    return sizeof(cmd_packet_gs) + payloadsize + 1;
+}
+
+size_t YDlidarDriver::frameCommand(const LidarCommand &command, uint8_t *frame) {
+    cmd_packet_gs *header = reinterpret_cast<cmd_packet_gs *>(frame);
+    size_t payloadsize = command.payload ? (command.size & 0xffff) : 0;
+    uint8_t checksum = 0;
+
     header->syncByte0 = LIDAR_CMD_SYNC_BYTE;
     header->syncByte1 = LIDAR_CMD_SYNC_BYTE;
     header->syncByte2 = LIDAR_CMD_SYNC_BYTE;
     header->syncByte3 = LIDAR_CMD_SYNC_BYTE;
-    header->address = addr;
-    header->cmd_flag = cmd;
-    header->size = 0xffff&payloadsize;
-    sendData(pkt_header, 8) ;
-    checksum += cmd;
-    checksum += 0xff&header->size;
-    checksum += 0xff&(header->size>>8);
-
-    if (payloadsize && payload) {
-      for (size_t pos = 0; pos < payloadsize; ++pos) {
-        checksum += ((uint8_t *)payload)[pos];
-      }
-      uint8_t sizebyte = (uint8_t)(payloadsize);
-      sendData((const uint8_t *)payload, sizebyte);
-    }
+    header->address = command.address;
+    header->cmd_flag = command.cmd_flag;
+    header->size = payloadsize;
+    checksum += command.cmd_flag;
+    checksum += 0xff & payloadsize;
+    checksum += 0xff & (payloadsize >> 8);
 
-    sendData(&checksum, 1);
+    uint8_t *data = frame + sizeof(cmd_packet_gs);
 
-    return RESULT_OK;
+    for (size_t pos = 0; pos < payloadsize; ++pos) {
+        data[pos] = reinterpret_cast<const uint8_t *>(command.payload)[pos];
+        checksum += data[pos];
+    }
+
+    data[payloadsize] = checksum;
+    return sizeof(cmd_packet_gs) + payloadsize + 1;
 }
 
 result_t YDlidarDriver::sendData(const uint8_t *data, size_t size) {
@@ -326,8 +449,9 @@ result_t YDlidarDriver::sendData(const uint8_t *data, size_t size) {
             return RESULT_FAIL;
         }
 
-        printf("send: ");
-        printHex(data, r);
+        if (Logger::enabled(LOG_LEVEL_DEBUG)) {
+            logHex("send: ", data, r);
+        }
 
         size -= r;
         data += r;
@@ -350,6 +474,9 @@ result_t YDlidarDriver::getData(uint8_t *data, size_t size) {
             return RESULT_FAIL;
         }
 
+        recorder.write(data, r);
+        metrics.addBytes(r);
+
 //        printf("recv: ");
 //        printHex(data, r);
 
@@ -362,82 +489,114 @@ result_t YDlidarDriver::getData(uint8_t *data, size_t size) {
 
 result_t YDlidarDriver::waitResponseHeader(gs_lidar_ans_header *header,
                                            uint32_t timeout) {
-    int  recvPos     = 0;
     uint32_t startTs = getms();
-    uint8_t  recvBuffer[sizeof(gs_lidar_ans_header)];
-    uint8_t  *headerBuffer = reinterpret_cast<uint8_t *>(header);
     uint32_t waitTime = 0;
     has_device_header = false;
     last_device_byte = 0x00;
-    
+
     while ((waitTime = getms() - startTs) <= timeout) {
-      size_t remainSize = sizeof(gs_lidar_ans_header) - recvPos;
-      size_t recvSize = 0;
-      result_t ans = waitForData(remainSize, timeout - waitTime, &recvSize);
-    
-      if (!IS_OK(ans)) {
-        return ans;
-      }
-    
-      if (recvSize > remainSize) {
-        recvSize = remainSize;
-      }
-    
-      ans = getData(recvBuffer, recvSize);
-    
-      if (IS_FAIL(ans)) {
-        return RESULT_FAIL;
-      }
-    
-      for (size_t pos = 0; pos < recvSize; ++pos) {
-        uint8_t currentByte = recvBuffer[pos];
-    
-        switch (recvPos) {
-            case 0:
-              if (currentByte != LIDAR_ANS_SYNC_BYTE1) {
-                  recvPos = 0;
-                  continue;
-              }
-              break;
-    
-            case 1:
-              if (currentByte != LIDAR_ANS_SYNC_BYTE1) {
-                  recvPos = 0;
-                  continue;
-              }
-              break;
-    
-            case 2:
-              if (currentByte != LIDAR_ANS_SYNC_BYTE1) {
-                  recvPos = 0;
-                  continue;
-              }
-              break;
-    
-            case 3:
-              if (currentByte != LIDAR_ANS_SYNC_BYTE1) {
-                  recvPos = 0;
-                  continue;
-              }
-              has_device_header = true;
-              break;
-    
-            default:
-              break;
+        result_t ans = fillRecvBuffer(sizeof(gs_lidar_ans_header), timeout - waitTime);
+
+        if (!IS_OK(ans)) {
+            return ans;
         }
-    
-        headerBuffer[recvPos++] = currentByte;
-        last_device_byte = currentByte;
-    
-        if (has_device_header && recvPos == sizeof(gs_lidar_ans_header)) {
-          return RESULT_OK;
+
+        if (!syncRecvBuffer() ||
+            recvTail - recvHead < sizeof(gs_lidar_ans_header)) {
+            continue;
         }
-      }
+
+        has_device_header = true;
+        memcpy(header, globalRecvBuffer + recvHead, sizeof(gs_lidar_ans_header));
+        recvHead += sizeof(gs_lidar_ans_header);
+        last_device_byte = globalRecvBuffer[recvHead - 1];
+        return RESULT_OK;
     }
 
     return RESULT_FAIL;
 }
 
+result_t YDlidarDriver::fillRecvBuffer(size_t size, uint32_t timeout) {
+    uint32_t startTs = getms();
+    uint32_t waitTime = 0;
+
+    while (recvTail - recvHead < size) {
+        //缓冲区尾部不足一包时, 将未处理数据移到缓冲区头部
+        if (recvHead > 0 && RecvBufferSize - recvTail < NORMAL_PACKAGE_SIZE) {
+            memmove(globalRecvBuffer, globalRecvBuffer + recvHead, recvTail - recvHead);
+            recvTail -= recvHead;
+            recvHead = 0;
+        }
+
+        if ((waitTime = getms() - startTs) > timeout) {
+            return RESULT_TIMEOUT;
+        }
+
+        size_t recvSize = 0;
+        result_t ans;
+        {
+            YDLIDAR_TRACE_SCOPE(TRACE_SERIAL_WAIT);
+            ans = waitForData(size - (recvTail - recvHead), timeout - waitTime,
+                              &recvSize);
+        }
+
+        if (!IS_OK(ans)) {
+            return ans;
+        }
+
+        uint64_t waitSurplus = 0;
+
+        if (_serial->getWaitSurplus(waitSurplus)) {
+            metrics.addWaitSurplus(waitSurplus);
+        }
+
+        if (recvSize > RecvBufferSize - recvTail) {
+            recvSize = RecvBufferSize - recvTail;
+        }
+
+        YDLIDAR_TRACE_SCOPE(TRACE_SERIAL_READ);
+
+        if (IS_FAIL(getData(globalRecvBuffer + recvTail, recvSize))) {
+            return RESULT_FAIL;
+        }
+
+        recvTail += recvSize;
+        recvStamp = getMonoTime();
+        recvClockOffset = static_cast<int64_t>(getTime() - recvStamp);
+    }
+
+    return RESULT_OK;
+}
+
+bool YDlidarDriver::syncRecvBuffer() {
+    YDLIDAR_TRACE_SCOPE(TRACE_HEADER_SYNC);
+    static const uint8_t syncWord[4] = {LIDAR_ANS_SYNC_BYTE1, LIDAR_ANS_SYNC_BYTE1,
+                                        LIDAR_ANS_SYNC_BYTE1, LIDAR_ANS_SYNC_BYTE1
+                                       };
+    uint8_t *end = globalRecvBuffer + recvTail;
+    uint8_t *pos = globalRecvBuffer + recvHead;
+    size_t head = recvHead;
+
+    while ((pos = reinterpret_cast<uint8_t *>(memchr(pos, LIDAR_ANS_SYNC_BYTE1,
+                  end - pos))) != NULL) {
+        if (end - pos < (ptrdiff_t)sizeof(syncWord)) {
+            break;
+        }
+
+        if (memcmp(pos, syncWord, sizeof(syncWord)) == 0) {
+            recvHead = pos - globalRecvBuffer;
+            metrics.addResyncBytes(recvHead - head);
+            return true;
+        }
+
+        pos++;
+    }
+
+    recvHead = pos ? pos - globalRecvBuffer : recvTail;
+    metrics.addResyncBytes(recvHead - head);
+    return false;
+}
+
 result_t YDlidarDriver::waitForData(size_t data_count, uint32_t timeout,
                                     size_t *returned_size) {
     size_t length = 0;
@@ -453,7 +612,7 @@ result_t YDlidarDriver::checkAutoConnecting() {
     result_t ans = RESULT_FAIL;
     isAutoconnting = true;
 
-    while (isAutoReconnect && isAutoconnting) {
+    while (isAutoReconnect && isAutoconnting && isScanning) {
         {
             ScopedLocker l(_serial_lock);
 
@@ -461,8 +620,11 @@ result_t YDlidarDriver::checkAutoConnecting() {
                 if (_serial->isOpen() || isConnected) {
                     isConnected = false;
                     _serial->closePort();
-                    delete _serial;
-                    _serial = NULL;
+
+                    if (!external_serial) {
+                        delete _serial;
+                        _serial = NULL;
+                    }
                 }
             }
         }
@@ -472,10 +634,14 @@ result_t YDlidarDriver::checkAutoConnecting() {
             retryCount = 100;
         }
 
-        delay(100 * retryCount);
+        //分段等待, 停止扫描或关闭自动重连后及时退出
+        for (int i = 0; i < retryCount * 10 && isAutoReconnect && isScanning; i++) {
+            delay(10);
+        }
+
         int retryConnect = 0;
 
-        while (isAutoReconnect &&
+        while (isAutoReconnect && isScanning &&
                connect(serial_port.c_str(), m_baudrate) != RESULT_OK) {
             retryConnect++;
 
@@ -483,10 +649,12 @@ result_t YDlidarDriver::checkAutoConnecting() {
                 retryConnect = 25;
             }
 
-            delay(200 * retryConnect);
+            for (int i = 0; i < retryConnect * 20 && isAutoReconnect && isScanning; i++) {
+                delay(10);
+            }
         }
 
-        if (!isAutoReconnect) {
+        if (!isAutoReconnect || !isScanning) {
             isScanning = false;
             return RESULT_FAIL;
         }
@@ -504,6 +672,7 @@ result_t YDlidarDriver::checkAutoConnecting() {
 
             if (IS_OK(ans)) {
                 isAutoconnting = false;
+                metrics.addReconnect();
                 return ans;
             }
         }
@@ -514,12 +683,13 @@ result_t YDlidarDriver::checkAutoConnecting() {
 }
 
 int YDlidarDriver::cacheScanData() {
-    node_info      local_buf[200];
+    GS2Point       local_buf[200];
     size_t         count = 200;
-    node_info      local_scan[MAX_SCAN_NODES];
-    size_t         scan_count = 0;
     result_t       ans = RESULT_FAIL;
-    memset(local_scan, 0, sizeof(local_scan));
+
+    if (Tracer::enabled()) {
+        Tracer::setThreadName("ydlidar scan");
+    }
 
     flushSerial();
     waitScanData(local_buf, count);
@@ -533,10 +703,18 @@ int YDlidarDriver::cacheScanData() {
         ans = waitScanData(local_buf, count);
 
         if (!IS_OK(ans)) {
+            //::disableDataGrabbing 取消了串口等待
+            if (!isScanning) {
+                break;
+            }
+
+            if (IS_TIMEOUT(ans)) {
+                metrics.addTimeout();
+            }
+
             if (IS_FAIL(ans) || timeout_count > DEFAULT_TIMEOUT_COUNT) {
                 if (!isAutoReconnect) {
-                    fprintf(stderr, "exit scanning thread!!\n");
-                    fflush(stderr);
+                    YDLIDAR_LOG(LOG_LEVEL_ERROR, "exit scanning thread!!");
                     {
                         isScanning = false;
                     }
@@ -546,7 +724,6 @@ int YDlidarDriver::cacheScanData() {
 
                     if (IS_OK(ans)) {
                         timeout_count = 0;
-                        local_scan[0].sync_flag = Node_NotSync;
                     } else {
                         isScanning = false;
                         return RESULT_FAIL;
@@ -554,9 +731,7 @@ int YDlidarDriver::cacheScanData() {
                 }
             } else {
                 timeout_count++;
-                local_scan[0].sync_flag = Node_NotSync;
-                fprintf(stderr, "timout count: %d\n", timeout_count);
-                fflush(stderr);
+                YDLIDAR_LOG(LOG_LEVEL_WARN, "timout count: %d", timeout_count);
             }
         } else {
             timeout_count = 0;
@@ -564,32 +739,51 @@ int YDlidarDriver::cacheScanData() {
         }
 
 
-        printf("sync:%d,index:%d,moduleNum:%d\n",package_type,frameNum,moduleNum);
-        fflush(stdout);
+        YDLIDAR_LOG_EVERY(LOG_LEVEL_DEBUG, 1000, "sync:%d,index:%d,moduleNum:%d",
+                          package_type, frameNum, moduleNum);
 
         if(!isPrepareToSend){
             continue;
         }
 
-        size_t size = multi_package.size();
-        for(size_t i = 0;i < size; i++){
-            if(multi_package[i].frameNum == frameNum && multi_package[i].moduleNum == moduleNum){
-                memcpy(scan_node_buf,multi_package[i].all_points,sizeof (node_info) * 160);
-                break;
+        {
+            YDLIDAR_TRACE_SCOPE(TRACE_HANDOFF);
+
+            //无损模式下等待消费者释放空位, 唤醒时队列可能仍为满
+            while (lossless_queue && isScanning && !scanQueue.writable()) {
+                scanQueue.waitWritable(DEFAULT_TIMEOUT);
+            }
+
+            //队列满时丢弃当前数据包
+            ModuleFrame *frame = scanQueue.beginWrite();
+
+            if (frame) {
+                memcpy(frame->points, ready_package->all_points, sizeof(frame->points));
+                memcpy(frame->samples, ready_package->samples, sizeof(frame->samples));
+                frame->last_stamp = ready_package->last_stamp;
+                frame->point_time = ready_package->point_time;
+                frame->index = ready_package->index;
+                frame->polar = ready_package->polar;
+                frame->cartesian = !ready_package->polar;
+
+                if (frame->cartesian) {
+                    memcpy(frame->x, ready_package->x, sizeof(frame->x));
+                    memcpy(frame->y, ready_package->y, sizeof(frame->y));
+                }
+                frame->module = moduleNum >> 1;//gs2:  1, 2, 4
+                frame->count = 160; //一个包固定160个数据
+                frame->recv_stamp = packageStamp;
+                frame->clock_offset = recvClockOffset;
+                scanQueue.commitWrite();
+            } else {
+                metrics.addDroppedFrame();
             }
         }
 
-        _lock.lock();//timeout lock, wait resource copys
-        scan_node_buf[0].stamp = local_buf[count - 1].stamp;
-        scan_node_buf[0].scan_frequence = local_buf[count - 1].scan_frequence;
-        scan_node_buf[0].index = moduleNum >> 1;//gs2:  1, 2, 4
-        scan_node_count = 160; //一个包固定160个数据
-        printf("send frameNum: %d,moduleNum: %d\n",frameNum,moduleNum);
-        fflush(stdout);
-        _dataEvent.set();
-        _lock.unlock();
-        scan_count = 0;
+        YDLIDAR_LOG_EVERY(LOG_LEVEL_DEBUG, 1000, "send frameNum: %d,moduleNum: %d",
+                          frameNum, moduleNum);
         isPrepareToSend = false;
+        ready_package = NULL;
     }
 
     isScanning = false;
@@ -597,433 +791,498 @@ int YDlidarDriver::cacheScanData() {
     return RESULT_OK;
 }
 
-result_t YDlidarDriver::waitPackage(node_info *node, uint32_t timeout)
+result_t YDlidarDriver::waitPackage(GS2Point *nodebuffer, size_t &count,
+                                    uint32_t timeout)
 {
-    int recvPos         = 0;
     uint32_t startTs    = getms();
     uint32_t waitTime   = 0;
-    uint8_t  *packageBuffer = (uint8_t *)&package;
-    isValidPoint  =  true;
-    int  package_recvPos    = 0;
-    uint16_t sample_lens = 0;
-    has_device_header = false;
-    uint16_t package_Sample_Num = 0;
-
-    (*node).index = 255;
-    (*node).scan_frequence  = 0;
+    const gs2_node_package *package = NULL;
+    count = 0;
 
-    if (package_Sample_Index == 0)
+    //同步包头: A5 A5 A5 A5 + 地址 + 类型 + 长度
+    while ((waitTime = getms() - startTs) <= timeout)
     {
-        recvPos = 0;
+        result_t ans = fillRecvBuffer(PackagePaidBytes_GS, timeout - waitTime);
 
-        while ((waitTime = getms() - startTs) <= timeout)
-        {
-            size_t remainSize   = PackagePaidBytes_GS - recvPos;
-            size_t recvSize     = 0;
-            CheckSumCal = 0;
-            result_t ans = waitForData(remainSize, timeout - waitTime, &recvSize);
+        if (!IS_OK(ans)) {
+            return ans;
+        }
 
-            if (!IS_OK(ans)) {
+        if (!syncRecvBuffer() || recvTail - recvHead < PackagePaidBytes_GS) {
+            continue;
+        }
+
+        package = reinterpret_cast<const gs2_node_package *>(globalRecvBuffer + recvHead);
+
+        //扫描中发出的命令的应答
+        if (package->package_CT != GS_LIDAR_ANS_SCAN) {
+            ans = routeReply(timeout - waitTime);
+
+            if (IS_TIMEOUT(ans)) {
                 return ans;
             }
 
-            if (recvSize > remainSize) {
-                recvSize = remainSize;
+            if (!IS_OK(ans)) {
+                recvHead++;
+                metrics.addResyncBytes(1);
             }
 
-            getData(globalRecvBuffer, recvSize);
+            package = NULL;
+            continue;
+        }
 
-            for (size_t pos = 0; pos < recvSize; ++pos)
-            {
-                uint8_t currentByte = globalRecvBuffer[pos];
-                switch (recvPos) {
-                case 0:
-                    if (currentByte != LIDAR_ANS_SYNC_BYTE1) {
-                        recvPos = 0;
-                        continue;
-                    }
-                    break;
+        //环境2Bytes + 点云320Bytes + CRC
+        if (package->size + 1 != sizeof(gs2_node_package) - PackagePaidBytes_GS) {
+            recvHead++;
+            metrics.addResyncBytes(1);
+            package = NULL;
+            continue;
+        }
 
-                case 1:
-                    if (currentByte != LIDAR_ANS_SYNC_BYTE1) {
-                        recvPos = 0;
-                        continue;
-                    }
-                    break;
+        break;
+    }
 
-                case 2:
-                    if (currentByte != LIDAR_ANS_SYNC_BYTE1) {
-                        recvPos = 0;
-                        continue;
-                    }
-                    break;
+    if (!package) {
+        return RESULT_TIMEOUT;
+    }
 
-                case 3:
-                    if (currentByte != LIDAR_ANS_SYNC_BYTE1) {
-                        recvPos = 0;
-                        continue;
-                    }
-                    has_device_header = true;
-                    break;
-
-                case 4:
-                    moduleNum = currentByte;
-                    CheckSumCal += currentByte;
-                    break;
-
-                case 5:
-                    if (currentByte != GS_LIDAR_ANS_SCAN) {
-                        recvPos = 0;
-                        CheckSumCal = 0;
-                        moduleNum = 0;
-                        has_device_header = false;
-                        continue;
-                    }
-                    CheckSumCal += currentByte;
-                    break;
+    waitTime = getms() - startTs;
 
-                case 6:
-                    sample_lens |= 0x00ff&currentByte;
-                    CheckSumCal += currentByte;
-                    break;
+    if (waitTime > timeout) {
+        return RESULT_TIMEOUT;
+    }
 
-                case 7:
-                    sample_lens |= (0x00ff&currentByte)<<8;
-                    CheckSumCal += currentByte;
-                    break;
+    result_t ans = fillRecvBuffer(sizeof(gs2_node_package), timeout - waitTime);
 
-                default :
-                    break;
-                }
+    if (!IS_OK(ans)) {
+        return ans;
+    }
 
-                packageBuffer[recvPos++] = currentByte;
-            }
+    //读取过程中缓冲区数据可能被移动
+    const uint8_t *packageBuffer = globalRecvBuffer + recvHead;
+    package = reinterpret_cast<const gs2_node_package *>(packageBuffer);
 
-            if (has_device_header &&
-                recvPos  == PackagePaidBytes_GS) {
-                package_Sample_Num = sample_lens+1;//环境2Bytes + 点云320Bytes + CRC
-                package_recvPos = recvPos;
-                printf("sample num %d\n", package_Sample_Num);
-                break;
-            }
-            else {
-                recvPos = 0;
-                printf("invalid data\n");
-                continue;
-            }
+    //校验和: 地址 + 类型 + 长度 + 数据
+    CheckSumCal = 0;
+    {
+        YDLIDAR_TRACE_SCOPE(TRACE_CHECKSUM);
+
+        for (size_t pos = 4; pos < sizeof(gs2_node_package) - 1; ++pos) {
+            CheckSumCal += packageBuffer[pos];
         }
+    }
 
-        if (PackagePaidBytes_GS == recvPos)
-        {
-            startTs = getms();
-            recvPos = 0;
+    CheckSum        = package->checkSum;
+    CheckSumResult  = CheckSumCal == CheckSum;
+    moduleNum       = package->address;
+    packageStamp    = recvStamp;
 
-            while ((waitTime = getms() - startTs) <= timeout)
-            {
-                size_t remainSize = package_Sample_Num - recvPos;
-                size_t recvSize = 0;
-                result_t ans = waitForData(remainSize, timeout - waitTime, &recvSize);
+    //数据包最后一个字节到达时间: 读取时间减去其后已读取字节的传输时间
+    uint64_t tail = recvTail - recvHead - sizeof(gs2_node_package);
+    uint64_t packageEnd = recvStamp - tail * trans_delay;
+    uint8_t mdNum = 0x03 & (moduleNum >> 1);
 
-                if (!IS_OK(ans)) {
-                    return ans;
-                }
+    if (CheckSumResult) {
+        metrics.addPacket(mdNum);
 
-                if (recvSize > remainSize) {
-                    recvSize = remainSize;
-                }
+        //按模组发送周期平滑, 去除读取调度抖动
+        if (mdNum < PackageMaxModuleNums) {
+            packageEnd = moduleClock[mdNum].update(packageEnd);
+        }
+    } else {
+        metrics.addChecksumError();
+    }
 
-                getData(globalRecvBuffer, recvSize);
+    //模组完成采样后开始发送, 最后一个点在数据包第一个字节发送前采集
+    packageLastStamp = packageEnd - sizeof(gs2_node_package) * trans_delay +
+                       recvClockOffset;
+    packagePointTime = modulePointTime(mdNum);
 
-                for (size_t pos = 0; pos < recvSize-1; pos++) {
-                    CheckSumCal += globalRecvBuffer[pos];
-                    packageBuffer[package_recvPos + recvPos] = globalRecvBuffer[pos];
-                    recvPos++;
-                }
-                CheckSum = globalRecvBuffer[recvSize-1];//crc
-                packageBuffer[package_recvPos + recvPos] = CheckSum;//crc
-                recvPos+=1;
+    //校验和错误的数据包原始采样点置零, 直角坐标输出无效点
+    if (CheckSumResult) {
+        memcpy(packageSamples, package->packageSample, sizeof(packageSamples));
+    } else {
+        memset(packageSamples, 0, sizeof(packageSamples));
+    }
 
-                if (package_Sample_Num == recvPos) {
-                    package_recvPos += recvPos;
-                    break;
-                }
-            }
+    parsePackage(*package, nodebuffer);
 
-            if (package_Sample_Num != recvPos) {
-                return RESULT_FAIL;
+    recvHead += sizeof(gs2_node_package);
+    count = PackageSampleMaxLngth_GS;
+
+    return RESULT_OK;
+}
+
+void YDlidarDriver::parsePackage(const gs2_node_package &package,
+                                 GS2Point *nodebuffer)
+{
+    uint8_t index = 0xff;
+    packagePolar = polar_transform;
+
+    if (CheckSumResult) {
+        package_index++;
+        index = package_index;
+    }
+
+    if (CheckSumResult && packagePolar) {
+        transformPoints(package.packageSample, 0x03 & (moduleNum >> 1), nodebuffer);
+    } else {
+        //不换算角度距离时在采集线程换算直角坐标, 与查找表更新不并发
+        if (!packagePolar) {
+            uint8_t mdNum = 0x03 & (moduleNum >> 1);
+
+            if (mdNum >= PackageMaxModuleNums) {
+                mdNum = 0;
             }
-        } else {
-            return RESULT_FAIL;
-        }
 
-        if (CheckSumCal != CheckSum) {
-            CheckSumResult = false;
-            has_package_error = true;
-        } else {
-            CheckSumResult = true;
+            cartesianTransform(packageSamples, transformTable[mdNum], packageX,
+                               packageY);
         }
-    }
 
-    if (!has_package_error) {
-        if (package_Sample_Index == 0) {
-            package_index++;
-            (*node).index = package_index;
+        //校验和错误或不换算角度距离时输出无效点
+        for (int i = 0; i < PackageSampleMaxLngth_GS; i++) {
+            GS2Point &node = nodebuffer[i];
+            node.sync_flag          = Node_NotSync;
+            node.quality            = Node_Default_Quality;
+            node.angle_q6_checkbit  = LIDAR_RESP_MEASUREMENT_CHECKBIT;
+            node.distance_q2        = 0;
+            node.reserved           = 0;
         }
-    } else {
-        (*node).index = 255;
-        package_index = 0xff;
+
+        nodebuffer[PackageSampleMaxLngth_GS - 1].sync_flag = Node_Sync;
     }
 
-    if (CheckSumResult) {
-        (*node).index = package_index;
-        (*node).scan_frequence  = scan_frequence;
+    packageIndex = index;
+}
+
+void YDlidarDriver::transformPoints(const GS2PackageNode *samples, uint8_t mdNum,
+                                    GS2Point *nodebuffer) const
+{
+    YDLIDAR_TRACE_SCOPE(TRACE_TRANSFORM);
+    float theta[PackageSampleMaxLngth_GS];
+    float range[PackageSampleMaxLngth_GS];
+
+    if (mdNum >= PackageMaxModuleNums) {
+        mdNum = 0;
     }
 
-    (*node).sync_quality = Node_Default_Quality;
-    (*node).stamp = 0;
-    (*node).scan_frequence = 0;
+    batchTransform(samples, transformTable[mdNum], theta, range);
 
-    double sampleAngle = 0;
-    if (CheckSumResult)
+    for (int i = 0; i < PackageSampleMaxLngth_GS; i++)
     {
-        (*node).distance_q2 =
-                package.packageSample[package_Sample_Index].PakageSampleDistance;
+        GS2Point &node = nodebuffer[i];
+        node.sync_flag          = Node_NotSync;
+        node.quality            = Node_Default_Quality;
+        node.angle_q6_checkbit  = LIDAR_RESP_MEASUREMENT_CHECKBIT;
+        node.distance_q2        = 0;
+        node.reserved           = 0;
+
+        double sampleAngle = theta[i];
+        uint16_t dist = (uint16_t)range[i];
 
         if (m_intensities) {
-            (*node).sync_quality = (uint16_t)package.packageSample[package_Sample_Index].PakageSampleQuality;
+            node.quality = samples[i].PakageSampleQuality;
         }
 
-        if (node->distance_q2 > 0)
-        {
-            angTransform((*node).distance_q2,package_Sample_Index,&sampleAngle,&(*node).distance_q2);
-        }
+        uint16_t angle_q6;
 
-//        printf("%lf ", sampleAngle);
-        if (sampleAngle< 0) {
-            (*node).angle_q6_checkbit = (((uint16_t)(sampleAngle * 64 + 23040)) << LIDAR_RESP_MEASUREMENT_ANGLE_SHIFT) +
-                    LIDAR_RESP_MEASUREMENT_CHECKBIT;
+        if (sampleAngle < 0) {
+            angle_q6 = (uint16_t)(sampleAngle * 64 + 23040);
+        } else if ((sampleAngle * 64) > 23040) {
+            angle_q6 = (uint16_t)(sampleAngle * 64 - 23040);
         } else {
-            if ((sampleAngle * 64) > 23040) {
-                (*node).angle_q6_checkbit = (((uint16_t)(sampleAngle * 64 - 23040)) << LIDAR_RESP_MEASUREMENT_ANGLE_SHIFT) +
-                        LIDAR_RESP_MEASUREMENT_CHECKBIT;
-            } else {
-                (*node).angle_q6_checkbit = (((uint16_t)(sampleAngle * 64)) << LIDAR_RESP_MEASUREMENT_ANGLE_SHIFT) +
-                        LIDAR_RESP_MEASUREMENT_CHECKBIT;
+            angle_q6 = (uint16_t)(sampleAngle * 64);
+        }
+
+        node.angle_q6_checkbit = (angle_q6 << LIDAR_RESP_MEASUREMENT_ANGLE_SHIFT) +
+                                 LIDAR_RESP_MEASUREMENT_CHECKBIT;
+
+        //前80个点应落在(180, 360)度, 后80个点应落在[0, 180]度, 越界点距离置零
+        if (i < 80) {
+            if (node.angle_q6_checkbit > 23041) {
+                node.distance_q2 = dist;
             }
+        } else if (node.angle_q6_checkbit <= 23041) {
+            node.distance_q2 = dist;
         }
+    }
+
+    nodebuffer[PackageSampleMaxLngth_GS - 1].sync_flag = Node_Sync;
+}
+
+uint64_t YDlidarDriver::modulePointTime(uint8_t mdNum) const {
+    uint64_t period = 0;
+
+    if (mdNum < PackageMaxModuleNums) {
+        period = moduleClock[mdNum].period();
+    }
+
+    if (!period) {
+        return m_PointTime;
+    }
+
+    return period / PackageSampleMaxLngth_GS;
+}
 
-        if(package_Sample_Index < 80){ //CT_RingStart  CT_Normal
-            if((*node).angle_q6_checkbit <= 23041){
-                (*node).distance_q2 = 0;
-                isValidPoint = false;
+void YDlidarDriver::resetModuleClock() {
+    for (int i = 0; i < PackageMaxModuleNums; i++) {
+        moduleClock[i].reset();
+    }
+}
+
+void YDlidarDriver::angTransform(uint8_t mdNum, uint16_t dist, int n,
+                                 double *dstTheta, uint16_t *dstDist)
+{
+    if (mdNum >= PackageMaxModuleNums) {
+        mdNum = 0;
+    }
+
+    //标定后像素坐标系下: X = dist, Y = (dist - Px) * tan + Py
+    double tempX = dist;
+    double tempY = (dist - Angle_Px) * calibrationTable[mdNum][n];
+
+    if (n < 80) {
+        tempY = tempY - Angle_Py; //5.315
+    } else {
+        tempY = tempY + Angle_Py;
+    }
+
+    double Dist = sqrt(tempX * tempX + tempY * tempY);
+    double theta = atan(tempY / tempX) * 180 / M_PI;
+
+    if (theta < 0)
+    {
+      theta += 360;
+    }
+    *dstTheta = theta;
+    *dstDist = Dist;
+}
+
+void YDlidarDriver::updateCalibrationTable(uint8_t mdNum)
+{
+    double pixelU, tempTheta;
+    double angle = (Angle_PAngle + bias[mdNum]) * M_PI / 180;
+    //消费者线程补算时读取查找表
+    ScopedLocker l(table_lock);
+
+    for (int n = 0; n < PackageSampleMaxLngth_GS; n++)
+    {
+        if (n < 80)
+        {
+            pixelU = 80 - n;
+            if (d_compensateB0[mdNum] > 1) {
+                tempTheta = d_compensateK0[mdNum] * pixelU - d_compensateB0[mdNum];
+            }
+            else
+            {
+                tempTheta = atan(d_compensateK0[mdNum] * pixelU - d_compensateB0[mdNum]) * 180 / M_PI;
+            }
+            calibrationTable[mdNum][n] = tan(tempTheta * M_PI / 180 - angle);
+        }
+        else
+        {
+            pixelU = 160 - n;
+            if (d_compensateB1[mdNum] > 1)
+            {
+                tempTheta = d_compensateK1[mdNum] * pixelU - d_compensateB1[mdNum];
             }
-        }else {
-            if((*node).angle_q6_checkbit > 23041){
-                (*node).distance_q2 = 0;
-                isValidPoint = false;
+            else
+            {
+                tempTheta = atan(d_compensateK1[mdNum] * pixelU - d_compensateB1[mdNum]) * 180 / M_PI;
             }
+            calibrationTable[mdNum][n] = tan(tempTheta * M_PI / 180 + angle);
         }
 
-//        printf("%d(%d) ", node->distance_q2, package_Sample_Index);
+        transformTable[mdNum].k[n] = (float)calibrationTable[mdNum][n];
+        transformTable[mdNum].c[n] = (float)(n < 80 ? -Angle_Py : Angle_Py);
+    }
+}
 
-    } else {
-        (*node).sync_flag       = Node_NotSync;
-        (*node).sync_quality    = Node_Default_Quality;
-        (*node).angle_q6_checkbit = LIDAR_RESP_MEASUREMENT_CHECKBIT;
-        (*node).distance_q2      = 0;
-        (*node).scan_frequence  = 0;
+const GS2TransformTable &YDlidarDriver::moduleTransformTable(uint8_t mdNum) const {
+    if (mdNum >= PackageMaxModuleNums) {
+        mdNum = 0;
     }
 
-    uint8_t nowPackageNum = 160;
+    return transformTable[mdNum];
+}
 
-    package_Sample_Index++;
-    (*node).sync_flag = Node_NotSync;
+GS2_Multi_Package *YDlidarDriver::packageSlot(uint8_t address, uint8_t frame) {
+    switch (address) {
+    case 1:
+    case 2:
+    case 4:
+        return &multi_package[address >> 1][frame & (PackageFrameSlotNums - 1)];
 
-    if (package_Sample_Index >= nowPackageNum) {
-        package_Sample_Index = 0;
-        (*node).sync_flag = Node_Sync;
-        CheckSumResult = false;
+    default:
+        return NULL;
     }
-
-    return RESULT_OK;
 }
 
-void YDlidarDriver::angTransform(uint16_t dist, int n, double *dstTheta, uint16_t *dstDist)
-{
-    double pixelU = n, Dist, theta, tempTheta, tempDist, tempX, tempY;
-    uint8_t mdNum = 0x03 & (moduleNum >> 1);//1,2,4
-    if (n < 80)
-    {
-      pixelU = 80 - pixelU;
-      if (d_compensateB0[mdNum] > 1) {
-          tempTheta = d_compensateK0[mdNum] * pixelU - d_compensateB0[mdNum];
-      }
-      else
-      {
-          tempTheta = atan(d_compensateK0[mdNum] * pixelU - d_compensateB0[mdNum]) * 180 / M_PI;
-      }
-      tempDist = (dist - Angle_Px) / cos(((Angle_PAngle + bias[mdNum]) - (tempTheta)) * M_PI / 180);
-      tempTheta = tempTheta * M_PI / 180;
-      tempX = cos((Angle_PAngle + bias[mdNum]) * M_PI / 180) * tempDist * cos(tempTheta) + sin((Angle_PAngle + bias[mdNum]) * M_PI / 180) * (tempDist *
-                                                                                             sin(tempTheta));
-      tempY = -sin((Angle_PAngle + bias[mdNum]) * M_PI / 180) * tempDist * cos(tempTheta) + cos((Angle_PAngle + bias[mdNum]) * M_PI / 180) * (tempDist *
-                                                                                              sin(tempTheta));
-      tempX = tempX + Angle_Px;
-      tempY = tempY - Angle_Py; //5.315
-      Dist = sqrt(tempX * tempX + tempY * tempY);
-      theta = atan(tempY / tempX) * 180 / M_PI;
-    }
-    else
-    {
-      pixelU = 160 - pixelU;
-      if (d_compensateB1[mdNum] > 1)
-      {
-          tempTheta = d_compensateK1[mdNum] * pixelU - d_compensateB1[mdNum];
-      }
-      else
-      {
-          tempTheta = atan(d_compensateK1[mdNum] * pixelU - d_compensateB1[mdNum]) * 180 / M_PI;
-      }
-      tempDist = (dist - Angle_Px) / cos(((Angle_PAngle + bias[mdNum]) + (tempTheta)) * M_PI / 180);
-      tempTheta = tempTheta * M_PI / 180;
-      tempX = cos(-(Angle_PAngle + bias[mdNum]) * M_PI / 180) * tempDist * cos(tempTheta) + sin(-(Angle_PAngle + bias[mdNum]) * M_PI / 180) * (tempDist *
-                                                                                               sin(tempTheta));
-      tempY = -sin(-(Angle_PAngle + bias[mdNum]) * M_PI / 180) * tempDist * cos(tempTheta) + cos(-(Angle_PAngle + bias[mdNum]) * M_PI / 180) * (tempDist *
-                                                                                                sin(tempTheta));
-      tempX = tempX + Angle_Px;
-      tempY = tempY + Angle_Py; //5.315
-      Dist = sqrt(tempX * tempX + tempY * tempY);
-      theta = atan(tempY / tempX) * 180 / M_PI;
-    }
-    if (theta < 0)
-    {
-      theta += 360;
+void  YDlidarDriver::addPointsToVec(GS2Point *nodebuffer, size_t &count){
+    GS2_Multi_Package *package = packageSlot(moduleNum, frameNum);
+
+    if (!package) {
+        return;
     }
-    *dstTheta = theta;
-    *dstDist = Dist;
-}
 
-void  YDlidarDriver::addPointsToVec(node_info *nodebuffer, size_t &count){
-    size_t size = multi_package.size();
-    bool isFound = false;
-    for(size_t i =0;i < size; i++){
-        if(multi_package[i].frameNum == frameNum && multi_package[i].moduleNum == moduleNum){
-            isFound = true;
-		    memcpy(multi_package[i].all_points,nodebuffer,sizeof (node_info) * count);
-            isPrepareToSend = true;
-            if(frameNum > 0){
-                int lastFrame = frameNum - 1;
-                for(size_t j =0;j < size; j++){
-                    if(multi_package[j].frameNum == lastFrame && multi_package[j].moduleNum == moduleNum){
-                        break;
-                    }
-                }
-            }
-            break;
+    if (package->frameNum == frameNum && package->moduleNum == moduleNum) {
+        memcpy(package->all_points, nodebuffer, sizeof (GS2Point) * count);
+        memcpy(package->samples, packageSamples, sizeof(packageSamples));
+        package->last_stamp = packageLastStamp;
+        package->point_time = packagePointTime;
+        package->index = packageIndex;
+        package->polar = packagePolar;
+
+        if (!packagePolar) {
+            memcpy(package->x, packageX, sizeof(packageX));
+            memcpy(package->y, packageY, sizeof(packageY));
         }
+        ready_package = package;
+        isPrepareToSend = true;
+    } else {
+        //槽位被旧帧占用或未使用, 复用槽位
+        package->frameNum = frameNum;
+        package->moduleNum = moduleNum;
     }
-    if(!isFound){
-        GS2_Multi_Package  package;
-        package.frameNum = frameNum;
-        package.moduleNum = moduleNum;
-        multi_package.push_back(package);
-    }
-    //   printf("add points, [sync:%d] [%u]\n",package_type,frameNum);
-    //   fflush(stdout);
 }
 
-result_t YDlidarDriver::waitScanData(node_info *nodebuffer, size_t &count,
+result_t YDlidarDriver::waitScanData(GS2Point *nodebuffer, size_t &count,
                                      uint32_t timeout) {
-    if (!isConnected) {
+    if (!isConnected || count < PackageSampleMaxLngth_GS) {
         count = 0;
         return RESULT_FAIL;
     }
 
-    size_t     recvNodeCount    =  0;
-    uint32_t   startTs          = getms();
-    uint32_t   waitTime         = 0;
-    result_t   ans              = RESULT_FAIL;
+    result_t ans = waitPackage(nodebuffer, count, timeout);
+
+    if (!IS_OK(ans)) {
+        count = 0;
+        return ans;
+    }
 
-    while ((waitTime = getms() - startTs) <= timeout && recvNodeCount < count)
     {
-        node_info node;
-        memset(&node, 0, sizeof(node_info));
-        ans = waitPackage(&node, timeout - waitTime);
+        YDLIDAR_TRACE_SCOPE(TRACE_ADD_POINTS);
+        addPointsToVec(nodebuffer, count);
+    }
 
-        if (!IS_OK(ans)) {
-            count = recvNodeCount;
-            return ans;
-        }
-        nodebuffer[recvNodeCount++] = node;
-//        printf("%d ", node.distance_q2);
+    return RESULT_OK;
+}
 
-        if (!package_Sample_Index)
-        {
-//            printf("\n");
+result_t YDlidarDriver::grabScanData(node_info *nodebuffer, size_t &count,
+                                     uint32_t timeout) {
+    ModuleFrame frame;
+    result_t ans = grabScanData(frame, timeout);
 
-            size_t size = _serial->available();
-            uint64_t delayTime = 0;
-            size_t PackageSize = NORMAL_PACKAGE_SIZE;
+    if (!IS_OK(ans)) {
+        count = 0;
+        return ans;
+    }
 
-            if (size > PackagePaidBytes_GS) {
-                size_t packageNum = size / PackageSize;
-                size_t Number = size % PackageSize;
-                delayTime = packageNum * m_PointTime * PackageSize / 2;
+    if (!frame.polar) {
+        ScopedLocker l(table_lock);
+        transformPoints(frame.samples, frame.module, frame.points);
+    }
 
-                if (Number > PackagePaidBytes_GS) {
-                    delayTime += m_PointTime * ((Number - PackagePaidBytes_GS) / 2);
-                }
+    count = min(count, frame.count);
+    toNodeInfo(frame, nodebuffer, count);
+    return RESULT_OK;
+}
 
-                size = Number;
+result_t YDlidarDriver::grabScanData(ModuleFrame &frame, uint32_t timeout) {
+    uint32_t startTs = getms();
+    uint32_t waitTime = 0;
+    const ModuleFrame *front = NULL;
 
-                if (packageNum > 0 && Number == 0) {
-                    size = PackageSize;
-                }
-            }
-            addPointsToVec(nodebuffer,recvNodeCount);
+    while ((front = scanQueue.front()) == NULL) {
+        if (!isScanning) {
+            return RESULT_FAIL;
+        }
 
-            nodebuffer[recvNodeCount - 1].stamp = size * trans_delay + delayTime;
-            nodebuffer[recvNodeCount - 1].scan_frequence = node.scan_frequence;
-            count = recvNodeCount;
-            return RESULT_OK;
+        if ((waitTime = getms() - startTs) >= timeout) {
+            return RESULT_TIMEOUT;
         }
 
-        if (recvNodeCount == count) {
-            return RESULT_OK;
+        if (scanQueue.wait(timeout - waitTime) == Event::EVENT_FAILED) {
+            return RESULT_FAIL;
         }
     }
 
-    count = recvNodeCount;
-    return RESULT_FAIL;
+    frame = *front;
+    scan_sequence = frame.seq;
+    scan_clock_offset = frame.clock_offset;
+    metrics.addLatency(getMonoTime() - frame.recv_stamp);
+    scanQueue.pop();
+
+    //关闭换算期间入队的数据包
+    if (!frame.polar && polar_transform) {
+        ScopedLocker l(table_lock);
+        transformPoints(frame.samples, frame.module, frame.points);
+        frame.polar = true;
+    }
+
+    return RESULT_OK;
 }
 
+void YDlidarDriver::setPolarTransform(bool enable) {
+    polar_transform = enable;
+}
 
-result_t YDlidarDriver::grabScanData(node_info *nodebuffer, size_t &count,
-                                     uint32_t timeout) {
-    switch (_dataEvent.wait(timeout)) {
-    case Event::EVENT_TIMEOUT:
-        count = 0;
-        return RESULT_TIMEOUT;
+void YDlidarDriver::cartesianPoints(ModuleFrame &frame) {
+    if (frame.cartesian) {
+        return;
+    }
 
-    case Event::EVENT_OK: {
-        if (scan_node_count == 0) {
-            return RESULT_FAIL;
-        }
+    uint8_t mdNum = frame.module;
 
-        ScopedLocker l(_lock);
-        size_t size_to_copy = min(count, scan_node_count);
-        memcpy(nodebuffer, scan_node_buf, size_to_copy * sizeof(node_info));
-        count = size_to_copy;
-        scan_node_count = 0;
+    if (mdNum >= PackageMaxModuleNums) {
+        mdNum = 0;
     }
 
-        return RESULT_OK;
+    //开启换算期间入队的数据包
+    ScopedLocker l(table_lock);
+    cartesianTransform(frame.samples, transformTable[mdNum], frame.x, frame.y);
+    frame.cartesian = true;
+}
 
-    default:
-        count = 0;
-        return RESULT_FAIL;
+void YDlidarDriver::toNodeInfo(const ModuleFrame &frame, node_info *nodes,
+                               size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const GS2Point &point = frame.points[i];
+        node_info &node = nodes[i];
+        node.sync_flag          = point.sync_flag;
+        node.sync_quality       = point.quality;
+        node.angle_q6_checkbit  = point.angle_q6_checkbit;
+        node.distance_q2        = point.distance_q2;
+        node.stamp              = frame.stamp(i);
+        node.scan_frequence     = 0;
+        node.index              = frame.index;
+        memset(node.debug_info, 0, sizeof(node.debug_info));
+    }
+
+    //兼容接口: 第一个点的index为模组序号
+    if (count) {
+        nodes[0].index = frame.module;
     }
+}
+
+uint64_t YDlidarDriver::getScanSequence() const {
+    return scan_sequence;
+}
+
+int64_t YDlidarDriver::getScanClockOffset() const {
+    return scan_clock_offset;
+}
+
+uint64_t YDlidarDriver::getDroppedScanCount() const {
+    return scanQueue.dropped();
+}
 
+void YDlidarDriver::getMetrics(LidarMetrics &metrics) const {
+    this->metrics.snapshot(metrics);
+}
+
+void YDlidarDriver::resetMetrics() {
+    metrics.reset();
 }
 
 
@@ -1137,16 +1396,63 @@ result_t YDlidarDriver::ascendScanData(node_info *nodebuffer, size_t count) {
 /* get device parameters of gs lidar                                             */
 /************************************************************************/
 result_t YDlidarDriver::getDevicePara(gs_device_para &info, uint32_t timeout) {
+  gs_device_para infos[PackageMaxModuleNums];
+  uint8_t mask = 0;
+  result_t ans = getDevicePara(infos, mask, timeout);
+
+  if (!IS_OK(ans)) {
+    return ans;
+  }
+
+  if (mask != (1 << PackageMaxModuleNums) - 1) {
+    return RESULT_TIMEOUT;
+  }
+
+  info = infos[PackageMaxModuleNums - 1];
+  return RESULT_OK;
+}
+
+result_t YDlidarDriver::getDevicePara(gs_device_para *infos, uint8_t &mask,
+                                      uint32_t timeout) {
   result_t  ans;
   uint8_t crcSum, mdNum;
+  gs_device_para info;
   uint8_t *pInfo = reinterpret_cast<uint8_t *>(&info);
 
+  mask = 0;
+
   if (!isConnected) {
     return RESULT_FAIL;
   }
 
+  //扫描中由采集线程转交应答并更新标定参数
+  if (isScanning && !isAutoconnting) {
+    ScopedLocker l(_lock);
+    LidarCommand command = {0x00, GS_LIDAR_CMD_GET_PARAMETER, NULL, 0};
+    ans = requestReplies(command, PackageMaxModuleNums, timeout);
+
+    if (!IS_OK(ans) && !IS_TIMEOUT(ans)) {
+      return ans;
+    }
+
+    //超时时使用已到达的应答
+    for (int i = 0; i < reply_count; i++) {
+      mdNum = reply_header[i].address >> 1; // 1,2,4
+
+      if (mdNum > 2 || reply_header[i].size < (sizeof(gs_device_para) - 1)) {
+        return RESULT_FAIL;
+      }
+
+      memcpy(&infos[mdNum], reply_data[i], sizeof(gs_device_para));
+      mask |= 1 << mdNum;
+    }
+
+    return mask ? RESULT_OK : ans;
+  }
+
   disableDataGrabbing();
   flushSerial();
+  module_mask = 0;
   {
     ScopedLocker l(_lock);
 
@@ -1157,7 +1463,8 @@ result_t YDlidarDriver::getDevicePara(gs_device_para &info, uint32_t timeout) {
     for(int i = 0; i < PackageMaxModuleNums; i++)
     {
         if ((ans = waitResponseHeader(&response_header, timeout)) != RESULT_OK) {
-          return ans;
+          //超时时返回已到达的应答
+          return mask && IS_TIMEOUT(ans) ? RESULT_OK : ans;
         }
         if (response_header.type != GS_LIDAR_CMD_GET_PARAMETER) {
           return RESULT_FAIL;
@@ -1165,10 +1472,11 @@ result_t YDlidarDriver::getDevicePara(gs_device_para &info, uint32_t timeout) {
         if (response_header.size < (sizeof(gs_device_para) - 1)) {
           return RESULT_FAIL;
         }
-        if (waitForData(response_header.size+1, timeout) != RESULT_OK) {
+        if (fillRecvBuffer(sizeof(info), timeout) != RESULT_OK) {
           return RESULT_FAIL;
         }
-        getData(reinterpret_cast<uint8_t *>(&info), sizeof(info));
+        memcpy(&info, globalRecvBuffer + recvHead, sizeof(info));
+        recvHead += sizeof(info);
         
         crcSum = 0;
         crcSum += response_header.address;
@@ -1182,19 +1490,13 @@ result_t YDlidarDriver::getDevicePara(gs_device_para &info, uint32_t timeout) {
             return RESULT_FAIL;
         }
 
-        mdNum = response_header.address >> 1; // 1,2,4
-        if( mdNum > 2) {
-            return RESULT_FAIL;
+        if ((ans = applyDevicePara(response_header.address, info)) != RESULT_OK) {
+            return ans;
         }
-        u_compensateK0[mdNum] = info.u_compensateK0;
-        u_compensateK1[mdNum] = info.u_compensateK1;
-        u_compensateB0[mdNum] = info.u_compensateB0;
-        u_compensateB1[mdNum] = info.u_compensateB1;
-        d_compensateK0[mdNum] = info.u_compensateK0 / 10000.00;
-        d_compensateK1[mdNum] = info.u_compensateK1 / 10000.00;
-        d_compensateB0[mdNum] = info.u_compensateB0 / 10000.00;
-        d_compensateB1[mdNum] = info.u_compensateB1 / 10000.00;
-        bias[mdNum] = double(info.bias) * 0.1;
+
+        mdNum = response_header.address >> 1;
+        infos[mdNum] = info;
+        mask |= 1 << mdNum;
         delay(5);
     }
   }
@@ -1202,6 +1504,247 @@ result_t YDlidarDriver::getDevicePara(gs_device_para &info, uint32_t timeout) {
   return RESULT_OK;
 }
 
+result_t YDlidarDriver::applyDevicePara(uint8_t address,
+                                        const gs_device_para &info) {
+  uint8_t mdNum = address >> 1; // 1,2,4
+
+  if (mdNum > 2) {
+    return RESULT_FAIL;
+  }
+
+  module_mask |= 1 << mdNum;
+
+  if (u_compensateK0[mdNum] == info.u_compensateK0 &&
+      u_compensateK1[mdNum] == info.u_compensateK1 &&
+      u_compensateB0[mdNum] == info.u_compensateB0 &&
+      u_compensateB1[mdNum] == info.u_compensateB1 &&
+      bias[mdNum] == double(info.bias) * 0.1) {
+    return RESULT_OK;
+  }
+
+  u_compensateK0[mdNum] = info.u_compensateK0;
+  u_compensateK1[mdNum] = info.u_compensateK1;
+  u_compensateB0[mdNum] = info.u_compensateB0;
+  u_compensateB1[mdNum] = info.u_compensateB1;
+  d_compensateK0[mdNum] = info.u_compensateK0 / 10000.00;
+  d_compensateK1[mdNum] = info.u_compensateK1 / 10000.00;
+  d_compensateB0[mdNum] = info.u_compensateB0 / 10000.00;
+  d_compensateB1[mdNum] = info.u_compensateB1 / 10000.00;
+  bias[mdNum] = double(info.bias) * 0.1;
+  updateCalibrationTable(mdNum);
+  return RESULT_OK;
+}
+
+result_t YDlidarDriver::requestReplies(const LidarCommand &command, int count,
+                                       uint32_t timeout) {
+  result_t ans;
+
+  {
+    ScopedLocker l(reply_lock);
+    reply_type = command.cmd_flag;
+    reply_expected = min(count, (int)PackageMaxModuleNums);
+    reply_count = 0;
+    reply_event.set(false);
+  }
+
+  //::disableDataGrabbing 先清除isScanning再触发reply_event, 不会错过唤醒
+  ans = isScanning ? writeCommands(&command, 1) : RESULT_FAIL;
+
+  if (IS_OK(ans) && reply_event.wait(timeout) != Event::EVENT_OK) {
+    ans = RESULT_TIMEOUT;
+  }
+
+  //停止转交后采集线程不再写入应答
+  ScopedLocker l(reply_lock);
+
+  if (IS_OK(ans) && reply_count < reply_expected) {
+    ans = RESULT_TIMEOUT;
+  }
+
+  reply_type = 0;
+  return ans;
+}
+
+bool YDlidarDriver::loadCalibration() {
+  std::vector<CalibrationEntry> entries;
+  calibration_entries.clear();
+  calibration_cached = false;
+
+  if (calibration_cache.empty() || external_serial) {
+    return false;
+  }
+
+  if (!loadCalibrationCache(calibration_cache, serial_port, entries) ||
+      entries.size() != PackageMaxModuleNums) {
+    return false;
+  }
+
+  module_mask = 0;
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    if (applyDevicePara(entries[i].address, entries[i].para) != RESULT_OK) {
+      return false;
+    }
+  }
+
+  calibration_entries = entries;
+  calibration_cached = true;
+  YDLIDAR_LOG(LOG_LEVEL_INFO, "[YDLIDAR] Using cached calibration from %s",
+              calibration_cache.c_str());
+  return true;
+}
+
+int YDlidarDriver::validateCalibration() {
+  std::vector<CalibrationEntry> entries;
+  result_t ans;
+
+  {
+    ScopedLocker l(_lock);
+
+    if (!isScanning || isAutoconnting) {
+      return RESULT_FAIL;
+    }
+
+    LidarCommand command = {0x00, GS_LIDAR_CMD_GET_VERSION, NULL, 0};
+
+    if ((ans = requestReplies(command, PackageMaxModuleNums, 300)) != RESULT_OK) {
+      return ans;
+    }
+
+    for (int i = 0; i < PackageMaxModuleNums; i++) {
+      CalibrationEntry entry;
+      entry.address = reply_header[i].address;
+      entry.identity = calibrationIdentity(reply_data[i], reply_header[i].size);
+      memset(&entry.para, 0, sizeof(entry.para));
+      entries.push_back(entry);
+    }
+  }
+
+  //冷启动时使用扫描开始前读取的参数, 不再重复查询
+  if (!calibration_cached) {
+    for (size_t i = 0; i < entries.size(); i++) {
+      size_t j = 0;
+
+      while (j < calibration_entries.size() &&
+             calibration_entries[j].address != entries[i].address) {
+        j++;
+      }
+
+      if (j == calibration_entries.size()) {
+        return RESULT_FAIL;
+      }
+
+      entries[i].para = calibration_entries[j].para;
+    }
+  } else {
+    //使用缓存启动时重新查询, 采集线程收到应答时更新查找表
+    ScopedLocker l(_lock);
+
+    if (!isScanning || isAutoconnting) {
+      return RESULT_FAIL;
+    }
+
+    LidarCommand command = {0x00, GS_LIDAR_CMD_GET_PARAMETER, NULL, 0};
+
+    if ((ans = requestReplies(command, PackageMaxModuleNums, 300)) != RESULT_OK) {
+      return ans;
+    }
+
+    for (int i = 0; i < PackageMaxModuleNums; i++) {
+      size_t j = 0;
+
+      while (j < entries.size() && entries[j].address != reply_header[i].address) {
+        j++;
+      }
+
+      if (j == entries.size() ||
+          reply_header[i].size < (sizeof(gs_device_para) - 1)) {
+        return RESULT_FAIL;
+      }
+
+      memcpy(&entries[j].para, reply_data[i], sizeof(gs_device_para));
+    }
+  }
+
+  if (sameCalibration(entries, calibration_entries)) {
+    return RESULT_OK;
+  }
+
+  if (!storeCalibrationCache(calibration_cache, serial_port, entries)) {
+    YDLIDAR_LOG(LOG_LEVEL_WARN, "[YDLIDAR] Failed to write calibration cache %s",
+                calibration_cache.c_str());
+    return RESULT_FAIL;
+  }
+
+  YDLIDAR_LOG(LOG_LEVEL_INFO, "[YDLIDAR] Calibration cache %s updated",
+              calibration_cache.c_str());
+  return RESULT_OK;
+}
+
+result_t YDlidarDriver::routeReply(uint32_t timeout) {
+  const gs_lidar_ans_header *header =
+    reinterpret_cast<const gs_lidar_ans_header *>(globalRecvBuffer + recvHead);
+  uint8_t type = header->type;
+  size_t size = header->size;
+
+  {
+    ScopedLocker l(reply_lock);
+
+    if (reply_type == 0 || type != reply_type || size + 1 > REPLY_MAX_SIZE) {
+      return RESULT_FAIL;
+    }
+  }
+
+  result_t ans = fillRecvBuffer(sizeof(gs_lidar_ans_header) + size + 1, timeout);
+
+  if (!IS_OK(ans)) {
+    return ans;
+  }
+
+  //读取过程中缓冲区数据可能被移动
+  const uint8_t *reply = globalRecvBuffer + recvHead;
+  uint8_t crcSum = 0;
+
+  //校验和: 地址 + 类型 + 长度 + 数据
+  for (size_t pos = 4; pos < sizeof(gs_lidar_ans_header) + size; ++pos) {
+    crcSum += reply[pos];
+  }
+
+  if (crcSum != reply[sizeof(gs_lidar_ans_header) + size]) {
+    metrics.addChecksumError();
+    return RESULT_FAIL;
+  }
+
+  {
+    ScopedLocker l(reply_lock);
+
+    if (reply_type == type && reply_count < reply_expected) {
+      memcpy(&reply_header[reply_count], reply, sizeof(gs_lidar_ans_header));
+      memcpy(reply_data[reply_count], reply + sizeof(gs_lidar_ans_header),
+             size + 1);
+
+      //采集线程自己更新查找表, 不与数据包解析并发; 消费者线程的换算见table_lock
+      if (type == GS_LIDAR_CMD_GET_PARAMETER &&
+          size >= sizeof(gs_device_para) - 1) {
+        gs_device_para info;
+        memcpy(&info, reply_data[reply_count], sizeof(info));
+        applyDevicePara(reply_header[reply_count].address, info);
+      }
+
+      if (++reply_count == reply_expected) {
+        reply_event.set();
+      }
+    }
+  }
+
+  recvHead += sizeof(gs_lidar_ans_header) + size + 1;
+  return RESULT_OK;
+}
+
+uint8_t YDlidarDriver::getModuleMask() const {
+  return module_mask;
+}
+
 result_t YDlidarDriver::setDeviceAddress(uint32_t timeout)
 {
     result_t ans;
@@ -1214,6 +1757,20 @@ result_t YDlidarDriver::setDeviceAddress(uint32_t timeout)
         return RESULT_OK;
     }
 
+    //扫描中由采集线程转交应答
+    if (isScanning && !isAutoconnting) {
+        ScopedLocker l(_lock);
+        LidarCommand command = {0x00, GS_LIDAR_CMD_GET_ADDRESS, NULL, 0};
+
+        if ((ans = requestReplies(command, 1, timeout)) != RESULT_OK) {
+            return ans;
+        }
+
+        YDLIDAR_LOG(LOG_LEVEL_INFO, "[YDLIDAR] Lidar module count %d",
+                    (reply_header[0].address << 1) + 1);
+        return RESULT_OK;
+    }
+
     disableDataGrabbing();
     flushSerial();
     {
@@ -1232,7 +1789,8 @@ result_t YDlidarDriver::setDeviceAddress(uint32_t timeout)
             return RESULT_FAIL;
         }
 
-        printf("[YDLIDAR] Lidar module count %d", (response_header.address << 1) + 1);
+        YDLIDAR_LOG(LOG_LEVEL_INFO, "[YDLIDAR] Lidar module count %d",
+                    (response_header.address << 1) + 1);
     }
 
     return RESULT_OK;
@@ -1242,15 +1800,6 @@ result_t YDlidarDriver::setDeviceAddress(uint32_t timeout)
 /* the set to signal quality                                            */
 /************************************************************************/
 void YDlidarDriver::setIntensities(const bool &isintensities) {
-    if (m_intensities != isintensities) {
-        if (globalRecvBuffer) {
-            delete[] globalRecvBuffer;
-            globalRecvBuffer = NULL;
-        }
-
-        globalRecvBuffer = new uint8_t[sizeof(gs2_node_package)];
-    }
-
     m_intensities = isintensities;
 
     if (m_intensities) {
@@ -1336,11 +1885,23 @@ result_t YDlidarDriver::startScan(bool force, uint32_t timeout) {
     //配置GS2模组地址（三个模组）
     setDeviceAddress(300);
 
-    //获取GS2参数
-    gs_device_para gs2_info;
-//    delay(30);
-    getDevicePara(gs2_info, 300);  
-//    delay(30);
+    //获取GS2参数, 有缓存时直接使用缓存, 扫描开始后后台校验
+    if (!loadCalibration()) {
+        gs_device_para infos[PackageMaxModuleNums];
+        uint8_t mask = 0;
+
+        //保存读取到的参数, 后台写入缓存时使用
+        if (IS_OK(getDevicePara(infos, mask, 300)) &&
+                mask == (1 << PackageMaxModuleNums) - 1) {
+            for (int i = 0; i < PackageMaxModuleNums; i++) {
+                CalibrationEntry entry;
+                entry.address = 1 << i; // 1,2,4
+                entry.para = infos[i];
+                calibration_entries.push_back(entry);
+            }
+        }
+    }
+
     {
         flushSerial();
 
@@ -1359,12 +1920,16 @@ result_t YDlidarDriver::startScan(bool force, uint32_t timeout) {
             }
 
             if (response_header.type != GS_LIDAR_ANS_SCAN) {
-                printf("[CYdLidar] Response to start scan type error!\n");
+                YDLIDAR_LOG(LOG_LEVEL_ERROR, "[CYdLidar] Response to start scan type error!");
                 return RESULT_FAIL;
             }
         }
 
         ans = this->createThread();
+
+        if (IS_OK(ans) && !calibration_cache.empty() && !external_serial) {
+            _calib_thread = CLASS_THREAD(YDlidarDriver, validateCalibration);
+        }
     }
 
     return ans;
@@ -1397,6 +1962,7 @@ result_t YDlidarDriver::stopScan(uint32_t timeout) {
 }
 
 result_t YDlidarDriver::createThread() {
+    scanQueue.clear();
     _thread = CLASS_THREAD(YDlidarDriver, cacheScanData);
 
     if (_thread.getHandle() == 0) {
@@ -1479,6 +2045,33 @@ result_t YDlidarDriver::reset(uint8_t addr, uint32_t timeout) {
     return RESULT_OK;
 }
 
+result_t YDlidarDriver::resetModules(uint8_t mask, uint32_t timeout) {
+    UNUSED(timeout);
+    LidarCommand commands[PackageMaxModuleNums];
+    size_t count = 0;
+
+    if (!isConnected) {
+        return RESULT_FAIL;
+    }
+
+    for (int i = 0; i < PackageMaxModuleNums; i++) {
+        if (mask & (1 << i)) {
+            //模组地址为1, 2, 4
+            commands[count].address = 1 << i;
+            commands[count].cmd_flag = GS_LIDAR_CMD_RESET;
+            commands[count].payload = NULL;
+            commands[count].size = 0;
+            count++;
+        }
+    }
+
+    if (count == 0) {
+        return RESULT_OK;
+    }
+
+    return sendCommands(commands, count);
+}
+
 std::string YDlidarDriver::getSDKVersion() {
     return SDKVerision;
 }
@@ -0,0 +1,245 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+#include "ydlidar_log.h"
+#include "common.h"
+#include <stdarg.h>
+#include <stdlib.h>
+
+namespace ydlidar {
+
+std::atomic<int> Logger::s_level(LOG_LEVEL_INFO);
+
+namespace {
+
+/// 单条日志最大长度, 超出部分截断
+const size_t LogMessageSize = 256;
+
+struct LogRecord {
+  std::atomic<size_t> sequence;
+  int   level;
+  char  text[LogMessageSize];
+};
+
+/*!
+* 多生产者/单消费者有界日志队列 \n
+* 每个槽位的序号标识其是否可写/可读, 生产者之间只竞争写位置
+*/
+class LogWriter {
+ public:
+  enum {
+    Capacity = 1024,   ///< 队列容量, 必须为2的幂
+    WakeupSize = 64,   ///< 积压超过该数量时立即唤醒写线程
+    Interval = 50,     ///< 写线程最长等待时间[ms]
+  };
+
+  LogWriter() : _head(0), _tail(0), _dropped(0), _running(true),
+    _stopped(false, false) {
+    for (size_t i = 0; i < Capacity; i++) {
+      _records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    _thread = CLASS_THREAD(LogWriter, writerThread);
+  }
+
+  /*!
+  * @brief 放入一条日志(生产者)
+  */
+  void push(int level, const char *fmt, va_list args) {
+    size_t pos = _tail.load(std::memory_order_relaxed);
+    LogRecord *record = NULL;
+
+    for (;;) {
+      record = &_records[pos & (Capacity - 1)];
+      size_t seq = record->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+      if (diff == 0) {
+        if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      } else {
+        pos = _tail.load(std::memory_order_relaxed);
+      }
+    }
+
+    record->level = level;
+    vsnprintf(record->text, sizeof(record->text), fmt, args);
+    record->sequence.store(pos + 1, std::memory_order_release);
+
+    if (pos - _head.load(std::memory_order_relaxed) == WakeupSize) {
+      _event.set();
+    }
+  }
+
+  /*!
+  * @brief 写出队列中的全部日志(消费者)
+  */
+  void drain() {
+    ScopedLocker l(_drain_lock);
+    bool written = false;
+
+    for (;;) {
+      size_t pos = _head.load(std::memory_order_relaxed);
+      LogRecord *record = &_records[pos & (Capacity - 1)];
+
+      if (record->sequence.load(std::memory_order_acquire) != pos + 1) {
+        break;
+      }
+
+      FILE *out = record->level >= LOG_LEVEL_WARN ? stderr : stdout;
+      size_t size = strlen(record->text);
+      fputs(record->text, out);
+
+      if (!size || record->text[size - 1] != '\n') {
+        fputc('\n', out);
+      }
+
+      record->sequence.store(pos + Capacity, std::memory_order_release);
+      _head.store(pos + 1, std::memory_order_relaxed);
+      written = true;
+    }
+
+    if (written) {
+      fflush(stdout);
+      fflush(stderr);
+    }
+  }
+
+  /*!
+  * @brief 停止写线程并写出剩余日志, 进程退出时调用
+  */
+  void stop() {
+    _running = false;
+    _event.set();
+    _stopped.wait(1000);
+    drain();
+  }
+
+  bool running() const {
+    return _running;
+  }
+
+  uint64_t dropped() const {
+    return _dropped.load(std::memory_order_relaxed);
+  }
+
+ private:
+  int writerThread() {
+    while (_running) {
+      _event.wait(Interval);
+      drain();
+    }
+
+    _stopped.set();
+    return 0;
+  }
+
+ private:
+  LogRecord             _records[Capacity];
+  std::atomic<size_t>   _head;
+  std::atomic<size_t>   _tail;
+  std::atomic<uint64_t> _dropped;
+  std::atomic<bool>     _running;
+  Event                 _event;
+  Event                 _stopped;
+  Locker                _drain_lock;
+  Thread                _thread;
+};
+
+std::atomic<LogWriter *> log_writer(NULL);
+Locker     log_writer_lock;
+
+void stopLogWriter() {
+  log_writer.load()->stop();
+}
+
+/// 首次使用时创建写线程; 进程退出时停止, 之后的日志直接写出
+LogWriter *logWriter() {
+  LogWriter *writer = log_writer.load(std::memory_order_acquire);
+
+  if (!writer) {
+    ScopedLocker l(log_writer_lock);
+    writer = log_writer.load(std::memory_order_relaxed);
+
+    if (!writer) {
+      writer = new LogWriter();
+      log_writer.store(writer, std::memory_order_release);
+      atexit(stopLogWriter);
+    }
+  }
+
+  return writer;
+}
+
+}
+
+void Logger::log(int level, const char *fmt, ...) {
+  LogWriter *writer = logWriter();
+  va_list args;
+  va_start(args, fmt);
+  writer->push(level, fmt, args);
+  va_end(args);
+
+  if (!writer->running()) {
+    writer->drain();
+  }
+}
+
+void Logger::flush() {
+  logWriter()->drain();
+}
+
+uint64_t Logger::dropped() {
+  return logWriter()->dropped();
+}
+
+bool LogRateLimiter::allow(uint32_t interval, uint32_t &suppressed) {
+  uint64_t now = getms();
+  uint64_t last = _last.load(std::memory_order_relaxed);
+
+  if ((last && now - last < interval) ||
+      !_last.compare_exchange_strong(last, now ? now : 1,
+                                     std::memory_order_relaxed)) {
+    _suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  suppressed = _suppressed.exchange(0, std::memory_order_relaxed);
+  return true;
+}
+
+}// namespace ydlidar
@@ -0,0 +1,263 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+#include "ydlidar_trace.h"
+#include "locker.h"
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace ydlidar {
+
+std::atomic<bool> Tracer::s_enabled(false);
+
+namespace {
+
+const char *const StageNames[TRACE_STAGE_NUMS] = {
+  "serial wait",
+  "read",
+  "header sync",
+  "checksum",
+  "angTransform",
+  "addPointsToVec",
+  "handoff",
+  "doProcess",
+};
+
+struct TraceEvent {
+  uint64_t begin;
+  uint64_t end;
+  int      stage;
+};
+
+/*!
+* 单个线程的环形缓冲区 \n
+* 只有所属线程写入, 导出时根据写入位置丢弃可能被覆盖的事件
+*/
+struct TraceBuffer {
+  TraceBuffer(int id) : tid(id), active(false), position(0) {
+    events.resize(Tracer::BufferSize);
+  }
+
+  int                     tid;
+  std::string             name;
+  bool                    active;     ///< 是否有线程正在使用, 受buffers_lock保护
+  std::atomic<uint64_t>   position;   ///< 已写入的事件总数
+  std::vector<TraceEvent> events;
+};
+
+/*!
+* 缓冲区在线程退出后保留, 以便导出 \n
+* 线程退出后缓冲区变为空闲, 由新线程复用, 缓冲区数量不超过线程名称数加上同时记录的未命名线程数
+*/
+std::vector<TraceBuffer *> buffers;
+Locker buffers_lock;
+
+#if defined(_MSC_VER)
+__declspec(thread) TraceBuffer *local_buffer = NULL;
+#else
+__thread TraceBuffer *local_buffer = NULL;
+#endif
+
+/*!
+* 线程退出时释放缓冲区
+*/
+struct BufferOwner {
+  ~BufferOwner() {
+    ScopedLocker l(buffers_lock);
+
+    if (local_buffer) {
+      local_buffer->active = false;
+      local_buffer = NULL;
+    }
+  }
+};
+
+/*!
+* @brief 为当前线程分配缓冲区, 调用前需锁定buffers_lock \n
+* 复用同名的空闲缓冲区并保留其事件, 如重连后重新创建的采集线程;
+* 没有时复用未命名的空闲缓冲区并清空, 不占用其他名称的缓冲区
+*/
+TraceBuffer *acquireBuffer(const std::string &name) {
+  TraceBuffer *buffer = NULL;
+
+  for (size_t i = 0; i < buffers.size(); i++) {
+    if (buffers[i]->active) {
+      continue;
+    }
+
+    if (buffers[i]->name == name) {
+      buffer = buffers[i];
+      break;
+    }
+
+    if (!buffer && buffers[i]->name.empty()) {
+      buffer = buffers[i];
+    }
+  }
+
+  if (!buffer) {
+    buffer = new TraceBuffer(buffers.size() + 1);
+    buffer->name = name;
+    buffers.push_back(buffer);
+  } else if (buffer->name != name) {
+    buffer->name = name;
+    buffer->position.store(0, std::memory_order_relaxed);
+  }
+
+  buffer->active = true;
+  local_buffer = buffer;
+  static thread_local BufferOwner owner;
+  (void)owner;
+  return buffer;
+}
+
+TraceBuffer *threadBuffer() {
+  if (!local_buffer) {
+    ScopedLocker l(buffers_lock);
+    acquireBuffer(std::string());
+  }
+
+  return local_buffer;
+}
+
+/// 转义JSON字符串中的引号、反斜杠和控制字符
+std::string jsonEscape(const std::string &text) {
+  std::string escaped;
+
+  for (size_t i = 0; i < text.size(); i++) {
+    unsigned char c = text[i];
+
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (c < 0x20) {
+      char code[8];
+      snprintf(code, sizeof(code), "\\u%04x", c);
+      escaped += code;
+    } else {
+      escaped += c;
+    }
+  }
+
+  return escaped;
+}
+
+}
+
+void Tracer::setEnabled(bool enable) {
+  s_enabled.store(enable, std::memory_order_relaxed);
+}
+
+uint64_t Tracer::now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracer::record(TraceStage stage, uint64_t begin, uint64_t end) {
+  TraceBuffer *buffer = threadBuffer();
+  uint64_t position = buffer->position.load(std::memory_order_relaxed);
+  TraceEvent &event = buffer->events[position & (BufferSize - 1)];
+  event.begin = begin;
+  event.end = end;
+  event.stage = stage;
+  buffer->position.store(position + 1, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const char *name) {
+  ScopedLocker l(buffers_lock);
+
+  if (local_buffer) {
+    local_buffer->name = name;
+  } else {
+    acquireBuffer(name);
+  }
+}
+
+bool Tracer::dump(const std::string &path) {
+  FILE *file = fopen(path.c_str(), "w");
+
+  if (!file) {
+    return false;
+  }
+
+  ScopedLocker l(buffers_lock);
+  fprintf(file, "{\"traceEvents\":[\n");
+  bool first = true;
+
+  for (size_t i = 0; i < buffers.size(); i++) {
+    TraceBuffer *buffer = buffers[i];
+
+    if (!buffer->name.empty()) {
+      fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+              "\"tid\":%d,\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n",
+              buffer->tid, jsonEscape(buffer->name).c_str());
+      first = false;
+    }
+
+    uint64_t end = buffer->position.load(std::memory_order_acquire);
+    uint64_t start = end > BufferSize ? end - BufferSize : 0;
+    std::vector<TraceEvent> events(end - start);
+
+    for (uint64_t pos = start; pos < end; pos++) {
+      events[pos - start] = buffer->events[pos & (BufferSize - 1)];
+    }
+
+    //跳过复制期间可能被所属线程覆盖的事件
+    uint64_t position = buffer->position.load(std::memory_order_acquire);
+    uint64_t valid = position > BufferSize ? position - BufferSize : 0;
+
+    for (uint64_t pos = std::max(start, valid); pos < end; pos++) {
+      const TraceEvent &event = events[pos - start];
+      fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+              "\"ts\":%.3f,\"dur\":%.3f}", first ? "" : ",\n",
+              StageNames[event.stage], buffer->tid, event.begin / 1000.0,
+              (event.end - event.begin) / 1000.0);
+      first = false;
+    }
+  }
+
+  fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+  return fclose(file) == 0;
+}
+
+void Tracer::clear() {
+  ScopedLocker l(buffers_lock);
+
+  for (size_t i = 0; i < buffers.size(); i++) {
+    buffers[i]->position.store(0, std::memory_order_relaxed);
+  }
+}
+
+}// namespace ydlidar
@@ -0,0 +1,152 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+/*!
+* 批量换算精度测试 \n
+* 对当前编译器和CPU支持的每种指令集, 用多组标定参数、全部像素和0到9位最大值的距离
+* 比较::batchTransform 与::YDlidarDriver::angTransform 的结果,
+* 误差不得超过::GS2_TRANSFORM_ANGLE_TOLERANCE 和::GS2_TRANSFORM_RANGE_TOLERANCE
+*/
+#include "ydlidar_driver.h"
+#include "gs2_transform.h"
+#include <stdio.h>
+#include <math.h>
+using namespace ydlidar;
+
+namespace {
+
+const uint8_t ModuleAddress[PackageMaxModuleNums] = {0x01, 0x02, 0x04};
+const uint16_t CheckDists[] = {0, 1, 2, 5, 10, 30, 100, 200, 300, 400, 511};
+const int CheckCount = sizeof(CheckDists) / sizeof(CheckDists[0]);
+
+/*!
+* 开放标定接口的驱动
+*/
+class TestDriver : public YDlidarDriver {
+ public:
+  using YDlidarDriver::angTransform;
+  using YDlidarDriver::applyDevicePara;
+  using YDlidarDriver::moduleTransformTable;
+};
+
+/*!
+* @brief 比较一个模组全部像素和距离的换算结果
+* @return 误差数
+*/
+int checkModule(TestDriver &driver, BatchTransformFunc func, TransformISA isa,
+                uint8_t mdNum) {
+  GS2PackageNode samples[PackageSampleMaxLngth_GS];
+  float theta[PackageSampleMaxLngth_GS];
+  float range[PackageSampleMaxLngth_GS];
+  int errors = 0;
+
+  for (int d = 0; d < CheckCount; d++) {
+    for (int n = 0; n < PackageSampleMaxLngth_GS; n++) {
+      samples[n].PakageSampleDistance = CheckDists[d];
+      //信号强度位不得影响距离
+      samples[n].PakageSampleQuality = 0x7f;
+    }
+
+    func(samples, driver.moduleTransformTable(mdNum), theta, range);
+
+    for (int n = 0; n < PackageSampleMaxLngth_GS; n++) {
+      //距离为0的点不换算, 角度和距离均为0
+      double refAngle = 0;
+      uint16_t refDist = CheckDists[d];
+
+      if (refDist > 0) {
+        driver.angTransform(mdNum, refDist, n, &refAngle, &refDist);
+      }
+
+      double angleError = fabs(theta[n] - refAngle);
+
+      //0度与360度为同一角度
+      if (angleError > 180) {
+        angleError = 360 - angleError;
+      }
+
+      if (angleError > GS2_TRANSFORM_ANGLE_TOLERANCE ||
+          fabs(range[n] - refDist) > GS2_TRANSFORM_RANGE_TOLERANCE) {
+        if (errors < 10) {
+          fprintf(stderr, "%s: module %d, pixel %d, dist %d: %f/%f vs %f/%d\n",
+                  transformISAToString(isa), mdNum, n, CheckDists[d],
+                  theta[n], range[n], refAngle, refDist);
+        }
+
+        errors++;
+      }
+    }
+  }
+
+  return errors;
+}
+
+}
+
+int main() {
+  //默认(全零)参数, 典型标定参数和B大于1(线性补偿)的标定参数
+  gs_device_para paras[3] = {
+    {0, 0, 0, 0, 0, 0},
+    {125, 5000, 126, 5000, -1, 0},
+    {2, 12000, 3, 11000, 12, 0},
+  };
+  int errors = 0;
+  int checked = 0;
+
+  for (int p = 0; p < 3; p++) {
+    TestDriver driver;
+
+    for (int i = 0; i < PackageMaxModuleNums; i++) {
+      gs_device_para para = paras[p];
+      para.bias += i;
+      driver.applyDevicePara(ModuleAddress[i], para);
+    }
+
+    for (int isa = TRANSFORM_ISA_SCALAR; isa < TRANSFORM_ISA_Tail; isa++) {
+      BatchTransformFunc func = getBatchTransform(TransformISA(isa));
+
+      if (!func) {
+        continue;
+      }
+
+      for (uint8_t i = 0; i < PackageMaxModuleNums; i++) {
+        errors += checkModule(driver, func, TransformISA(isa), i);
+      }
+
+      checked++;
+    }
+  }
+
+  printf("checked %d transforms, %d mismatches\n", checked, errors);
+  return errors ? 1 : 0;
+}
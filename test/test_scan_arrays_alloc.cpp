@@ -0,0 +1,118 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+/*!
+* ::LaserScanArrays 输出的内存分配测试 \n
+* 回放合成数据, 重复使用同一::LaserScanArrays 调用::CYdLidar::doProcessSimple,
+* 首帧分配输出缓存后调用线程不得再分配内存
+*/
+#include "CYdLidar.h"
+#define YDLIDAR_TEST_COUNT_ALLOCATIONS
+#include "test_stream.h"
+#include <stdio.h>
+using namespace ydlidar;
+
+int main() {
+  const uint32_t packets = 3000;
+  const std::string path = "test_scan_arrays_alloc.rec";
+  std::vector<uint8_t> stream;
+  test::appendLidarStream(stream, packets);
+
+  if (!test::writeRecording(path, stream)) {
+    fprintf(stderr, "failed to write %s\n", path.c_str());
+    return 1;
+  }
+
+  CYdLidar laser;
+  laser.setSerialBaudrate(test::Baudrate);
+  laser.setReplayFile(path);
+  laser.setReplaySpeed(0);
+  laser.setFixedResolution(false);
+  laser.setAutoReconnect(false);
+  laser.setIntensity(true);
+  laser.setMaxAngle(160);
+  laser.setMinAngle(-150);
+  laser.setMinRange(30);
+  laser.setMaxRange(1000);
+  std::vector<float> ignore;
+  ignore.push_back(10);
+  ignore.push_back(30);
+  ignore.push_back(-100);
+  ignore.push_back(-90);
+  laser.setIgnoreArray(ignore);
+
+  if (!laser.initialize() || !laser.turnOn()) {
+    fprintf(stderr, "failed to replay %s\n", path.c_str());
+    remove(path.c_str());
+    return 1;
+  }
+
+  LaserScanArrays scan;
+  bool hardError;
+  uint64_t frames = 0;
+  uint64_t allocs = 0;
+
+  //回放结束前停止, 避免等待超时
+  while (frames < packets / 2) {
+    //只统计调用线程在::doProcessSimple 中的分配, 采集线程的分配不计入
+    test::allocations = 0;
+    test::countAllocations = true;
+    bool ret = laser.doProcessSimple(scan, hardError);
+    test::countAllocations = false;
+
+    if (!ret) {
+      break;
+    }
+
+    //首帧分配输出缓存, 不计入
+    if (frames) {
+      allocs += test::allocations;
+    }
+
+    frames++;
+  }
+
+  laser.turnOff();
+  laser.disconnecting();
+  remove(path.c_str());
+
+  printf("%llu frames, %llu allocations after the first frame\n",
+         (unsigned long long)frames, (unsigned long long)allocs);
+
+  if (frames < 2) {
+    fprintf(stderr, "too few frames\n");
+    return 1;
+  }
+
+  return allocs ? 1 : 0;
+}
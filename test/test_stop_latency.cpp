@@ -0,0 +1,358 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+/*!
+* 停止扫描延迟测试 \n
+* 按实时速度回放合成数据, 测量::YDlidarDriver::disableDataGrabbing 的耗时:
+* - 扫描中停止, 最大耗时不得超过一个数据包周期
+* - 串口断开后自动重连中停止, 不得等待重连退避
+* - (Linux) 伪终端上的真实串口, 采集线程阻塞在epoll_wait中时停止,
+*   最大耗时不得超过一个数据包周期
+*/
+#include "ydlidar_driver.h"
+#include "test_stream.h"
+#include "timer.h"
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#if defined(__linux__)
+#include <poll.h>
+#include <pty.h>
+#include <unistd.h>
+#endif
+using namespace ydlidar;
+
+namespace {
+
+/// 三个模组各30Hz时的数据包周期
+const uint64_t PacketPeriodNs = 1000000000ULL / (30 * PackageMaxModuleNums);
+const uint32_t Packets = 300;
+const int Cycles = 10;
+/// 自动重连中停止的最大耗时, 小于最短的重连退避(100ms)
+const uint64_t ReconnectStopNs = 50000000ULL;
+
+/*!
+* 可模拟拔出的回放串口, 拔出后无法重新打开
+*/
+class UnplugSerial : public ReplaySerial {
+ public:
+  explicit UnplugSerial(const std::string &path)
+    : ReplaySerial(path, 1.0), unplugged(false) {}
+
+  virtual bool open() {
+    return !unplugged && ReplaySerial::open();
+  }
+
+  void unplug() {
+    unplugged = true;
+    closePort();
+  }
+
+ private:
+  std::atomic<bool> unplugged;
+};
+
+/*!
+* 开放停止接口的驱动
+*/
+class TestDriver : public YDlidarDriver {
+ public:
+  using YDlidarDriver::disableDataGrabbing;
+};
+
+/// 应答立即到达, 之后每::PacketPeriodNs 到达一个数据包
+bool writePacedRecording(const std::string &path) {
+  std::vector<uint8_t> stream;
+  test::appendResponse(stream, 0, GS_LIDAR_CMD_GET_ADDRESS, NULL, 0);
+  test::appendDevicePara(stream);
+  test::appendResponse(stream, 0, GS_LIDAR_ANS_SCAN, NULL, 0);
+  size_t head = stream.size();
+  test::appendPackages(stream, Packets);
+
+  FILE *file = fopen(path.c_str(), "wb");
+
+  if (!file) {
+    return false;
+  }
+
+  SerialRecordHeader header;
+  memcpy(header.magic, SERIAL_RECORD_MAGIC, sizeof(header.magic));
+  header.version = SERIAL_RECORD_VERSION;
+  header.baudrate = test::Baudrate;
+  fwrite(&header, sizeof(header), 1, file);
+
+  SerialRecordChunk chunk;
+  chunk.stamp = 0;
+  chunk.size = head;
+  fwrite(&chunk, sizeof(chunk), 1, file);
+  fwrite(&stream[0], 1, head, file);
+
+  for (uint32_t p = 0; p < Packets; ++p) {
+    chunk.stamp = (p + 1) * PacketPeriodNs;
+    chunk.size = sizeof(gs2_node_package);
+    fwrite(&chunk, sizeof(chunk), 1, file);
+    fwrite(&stream[head + p * sizeof(gs2_node_package)], 1, chunk.size, file);
+  }
+
+  fclose(file);
+  return true;
+}
+
+/*!
+* @brief 开始扫描, 等待后停止
+* @param[in] unplug 停止前拔出串口并等待进入自动重连
+* @return 停止耗时[ns], 开始扫描失败返回0
+*/
+uint64_t stopLatency(const std::string &path, uint32_t wait, bool unplug) {
+  TestDriver driver;
+  UnplugSerial *serial = new UnplugSerial(path);
+  driver.setSerial(serial);
+  driver.setAutoReconnect(unplug);
+
+  if (!serial->open()) {
+    return 0;
+  }
+
+  driver.isConnected = true;
+
+  if (!IS_OK(driver.startScan())) {
+    return 0;
+  }
+
+  if (unplug) {
+    delay(50);
+    serial->unplug();
+  }
+
+  delay(wait);
+
+  if (!driver.isscanning()) {
+    return 0;
+  }
+
+  uint64_t start = getMonoTime();
+  driver.disableDataGrabbing();
+  return getMonoTime() - start;
+}
+
+#if defined(__linux__)
+/*!
+* 伪终端主端上的模组: 应答地址, 标定参数和开始扫描命令, 不发送数据包,
+* 扫描开始后采集线程一直阻塞在串口等待中
+*/
+class PtyModule {
+ public:
+  explicit PtyModule(int master)
+    : master_(master), running_(true), pos_(0), remaining_(0),
+      thread_(&PtyModule::run, this) {}
+
+  ~PtyModule() {
+    running_ = false;
+    thread_.join();
+  }
+
+ private:
+  void run() {
+    while (running_) {
+      pollfd pfd = {master_, POLLIN, 0};
+
+      if (poll(&pfd, 1, 10) <= 0) {
+        continue;
+      }
+
+      uint8_t buf[256];
+      ssize_t n = read(master_, buf, sizeof(buf));
+
+      for (ssize_t i = 0; i < n; ++i) {
+        parse(buf[i]);
+      }
+    }
+  }
+
+  /// 命令: A5 A5 A5 A5 + 地址 + 类型 + 长度(2) + 数据 + 校验和
+  void parse(uint8_t byte) {
+    if (pos_ < 4) {
+      pos_ = byte == LIDAR_ANS_SYNC_BYTE1 ? pos_ + 1 : 0;
+      return;
+    }
+
+    if (pos_ < 8) {
+      header_[pos_++ - 4] = byte;
+      remaining_ = header_[2] + (header_[3] << 8) + 1;
+      return;
+    }
+
+    if (--remaining_ == 0) {
+      respond(header_[1]);
+      pos_ = 0;
+    }
+  }
+
+  void respond(uint8_t cmd) {
+    std::vector<uint8_t> reply;
+
+    switch (cmd) {
+      case GS_LIDAR_CMD_GET_ADDRESS:
+        test::appendResponse(reply, 1, cmd, NULL, 0);
+        break;
+
+      case GS_LIDAR_CMD_GET_PARAMETER:
+        test::appendDevicePara(reply);
+        break;
+
+      case GS_LIDAR_CMD_SCAN:
+      case GS_LIDAR_CMD_STOP:
+        test::appendResponse(reply, 0, cmd, NULL, 0);
+        break;
+
+      default:
+        break;
+    }
+
+    if (!reply.empty()) {
+      ssize_t r = write(master_, &reply[0], reply.size());
+      (void)r;
+    }
+  }
+
+  int               master_;
+  std::atomic<bool> running_;
+  int               pos_;
+  size_t            remaining_;
+  uint8_t           header_[4];
+  std::thread       thread_;
+};
+
+/*!
+* @brief 伪终端上开始扫描, 采集线程阻塞在epoll_wait中时停止
+* @return 各次停止的最大耗时[ns], 失败返回0
+*/
+uint64_t ptyStopLatency() {
+  int master, slave;
+  char name[64];
+
+  if (openpty(&master, &slave, name, NULL, NULL) != 0) {
+    return 0;
+  }
+
+  uint64_t worst = 0;
+
+  {
+    //保持从端打开, 驱动关闭串口时主端不会挂断
+    PtyModule module(master);
+
+    for (int i = 0; i < Cycles; i++) {
+      TestDriver driver;
+      driver.setAutoReconnect(false);
+
+      if (!IS_OK(driver.connect(name, test::Baudrate)) ||
+          !IS_OK(driver.startScan())) {
+        worst = UINT64_MAX;
+        break;
+      }
+
+      delay(20 + 7 * i);
+
+      if (!driver.isscanning()) {
+        worst = UINT64_MAX;
+        break;
+      }
+
+      uint64_t start = getMonoTime();
+      driver.disableDataGrabbing();
+      worst = std::max(worst, getMonoTime() - start);
+    }
+  }
+
+  close(slave);
+  close(master);
+  return worst == UINT64_MAX ? 0 : worst;
+}
+#endif
+
+}
+
+int main() {
+  const std::string path = "test_stop_latency.rec";
+
+  if (!writePacedRecording(path)) {
+    fprintf(stderr, "failed to write %s\n", path.c_str());
+    return 1;
+  }
+
+  uint64_t worst = 0;
+  uint64_t sum = 0;
+  int errors = 0;
+
+  for (int i = 0; i < Cycles; i++) {
+    uint64_t ns = stopLatency(path, 50 + 7 * i, false);
+
+    if (!ns) {
+      fprintf(stderr, "cycle %d: failed to start scanning\n", i);
+      errors++;
+      continue;
+    }
+
+    sum += ns;
+    worst = std::max(worst, ns);
+  }
+
+  printf("scanning: %d cycles, mean %.3f ms, max %.3f ms, packet period %.3f ms\n",
+         Cycles, sum / 1e6 / Cycles, worst / 1e6, PacketPeriodNs / 1e6);
+
+  if (worst >= PacketPeriodNs) {
+    errors++;
+  }
+
+  //拔出后进入重连退避或重连重试
+  uint64_t reconnect = stopLatency(path, 300, true);
+  printf("reconnecting: %.3f ms, limit %.3f ms\n", reconnect / 1e6,
+         ReconnectStopNs / 1e6);
+
+  if (!reconnect || reconnect >= ReconnectStopNs) {
+    errors++;
+  }
+
+#if defined(__linux__)
+  uint64_t blocked = ptyStopLatency();
+  printf("pty, blocked in epoll_wait: %d cycles, max %.3f ms, limit %.3f ms\n",
+         Cycles, blocked / 1e6, PacketPeriodNs / 1e6);
+
+  if (!blocked || blocked >= PacketPeriodNs) {
+    errors++;
+  }
+#endif
+
+  remove(path.c_str());
+  return errors ? 1 : 0;
+}
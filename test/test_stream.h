@@ -0,0 +1,278 @@
+/*********************************************************************
+* Software License Agreement (BSD License)
+*
+*  Copyright (c) 2018, EAIBOT, Inc.
+*  All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without
+*  modification, are permitted provided that the following conditions
+*  are met:
+*
+*   * Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   * Redistributions in binary form must reproduce the above
+*     copyright notice, this list of conditions and the following
+*     disclaimer in the documentation and/or other materials provided
+*     with the distribution.
+*   * Neither the name of the Willow Garage nor the names of its
+*     contributors may be used to endorse or promote products derived
+*     from this software without specific prior written permission.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+*  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+*  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+*  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+*  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+*  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+*  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+*  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+*  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+*  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+*  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+*  POSSIBILITY OF SUCH DAMAGE.
+*********************************************************************/
+/*!
+* 测试用合成GS2数据流 \n
+* 生成模组应答和数据包并保存为::SerialRecorder 录制文件,
+* 供::CYdLidar::setReplayFile 回放, 测试、基准测试和gs2_emulator共用 \n
+* 定义YDLIDAR_TEST_COUNT_ALLOCATIONS后包含本文件时替换全局operator new/delete,
+* 统计开启计数的线程的内存分配次数, 每个程序只能有一个源文件这样包含
+*/
+#pragma once
+#include "ydlidar_protocol.h"
+#include "serial_record.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#if defined(YDLIDAR_TEST_COUNT_ALLOCATIONS)
+#include <new>
+#endif
+
+namespace ydlidar {
+namespace test {
+
+const uint8_t ModuleAddress[PackageMaxModuleNums] = {0x01, 0x02, 0x04};
+const uint32_t Baudrate = 921600;
+
+inline uint8_t checkSum(const uint8_t *data, size_t size) {
+  uint8_t sum = 0;
+
+  for (size_t i = 0; i < size; ++i) {
+    sum += data[i];
+  }
+
+  return sum;
+}
+
+inline void appendResponse(std::vector<uint8_t> &stream, uint8_t address,
+                           uint8_t type, const uint8_t *payload, uint16_t size) {
+  size_t offset = stream.size();
+  stream.resize(offset + sizeof(gs_lidar_ans_header) + size + 1);
+  gs_lidar_ans_header *header =
+    reinterpret_cast<gs_lidar_ans_header *>(&stream[offset]);
+  memset(header, LIDAR_ANS_SYNC_BYTE1, 4);
+  header->address = address;
+  header->type = type;
+  header->size = size;
+
+  if (size) {
+    memcpy(&stream[offset + sizeof(gs_lidar_ans_header)], payload, size);
+  }
+
+  stream.back() = checkSum(&stream[offset + 4], stream.size() - offset - 5);
+}
+
+/// 三个模组的标定参数应答
+inline void appendDevicePara(std::vector<uint8_t> &stream) {
+  for (int i = 0; i < PackageMaxModuleNums; ++i) {
+    gs_device_para para;
+    para.u_compensateK0 = 125 + i;
+    para.u_compensateB0 = 5000;
+    para.u_compensateK1 = 125 + i;
+    para.u_compensateB1 = 5000;
+    para.bias = i - 1;
+    appendResponse(stream, ModuleAddress[i], GS_LIDAR_CMD_GET_PARAMETER,
+                   reinterpret_cast<uint8_t *>(&para),
+                   sizeof(para) - sizeof(para.crc));
+  }
+}
+
+/// 三个模组的版本应答
+inline void appendVersion(std::vector<uint8_t> &stream) {
+  for (int i = 0; i < PackageMaxModuleNums; ++i) {
+    uint8_t version[3] = {1, 0, uint8_t(i)};
+    appendResponse(stream, ModuleAddress[i], GS_LIDAR_CMD_GET_VERSION, version,
+                   sizeof(version));
+  }
+}
+
+/*!
+* @brief 合成一个数据包, 距离随帧号变化并叠加rand()噪声
+* @param[out] package 数据包
+* @param[in]  address 模组地址
+* @param[in]  frame   帧号
+*/
+inline void makePackage(gs2_node_package &package, uint8_t address,
+                        uint32_t frame) {
+  memset(&package.package_Head, LIDAR_ANS_SYNC_BYTE1, 4);
+  package.address = address;
+  package.package_CT = GS_LIDAR_CMD_SCAN;
+  package.size = sizeof(package) - PackagePaidBytes_GS - 1;
+  package.BackgroudLight = 0x10;
+  double phase = (frame % 100) / 100.0 * 2 * M_PI;
+
+  for (int i = 0; i < PackageSampleMaxLngth_GS; ++i) {
+    package.packageSample[i].PakageSampleDistance =
+      uint16_t(200 + 80 * sin(i * M_PI / PackageSampleMaxLngth_GS + phase) +
+               rand() % 5);
+    package.packageSample[i].PakageSampleQuality = 40 + rand() % 60;
+  }
+
+  uint8_t *data = reinterpret_cast<uint8_t *>(&package);
+  package.checkSum = checkSum(data + 4, sizeof(package) - 5);
+}
+
+/// 三个模组轮流发送的数据包, 固定随机数种子保证每次相同
+inline void makePackages(std::vector<gs2_node_package> &packages,
+                         uint32_t packets) {
+  srand(1);
+  packages.resize(packets);
+
+  for (uint32_t p = 0; p < packets; ++p) {
+    makePackage(packages[p], ModuleAddress[p % PackageMaxModuleNums],
+                p / PackageMaxModuleNums);
+  }
+}
+
+inline void appendPackages(std::vector<uint8_t> &stream,
+                           const std::vector<gs2_node_package> &packages) {
+  if (packages.empty()) {
+    return;
+  }
+
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(&packages[0]);
+  stream.insert(stream.end(), data,
+                data + packages.size() * sizeof(gs2_node_package));
+}
+
+inline void appendPackages(std::vector<uint8_t> &stream, uint32_t packets) {
+  std::vector<gs2_node_package> packages;
+  makePackages(packages, packets);
+  appendPackages(stream, packages);
+}
+
+/*!
+* @brief 生成::CYdLidar 开启扫描的完整数据流 \n
+* connect和startScan的停止应答, 地址, 标定参数, 开始扫描应答, 数据包
+*/
+inline void appendLidarStream(std::vector<uint8_t> &stream,
+                              const std::vector<gs2_node_package> &packages) {
+  appendResponse(stream, 0, GS_LIDAR_CMD_STOP, NULL, 0);
+  appendResponse(stream, 0, GS_LIDAR_CMD_STOP, NULL, 0);
+  appendResponse(stream, 0, GS_LIDAR_CMD_GET_ADDRESS, NULL, 0);
+  appendDevicePara(stream);
+  appendResponse(stream, 0, GS_LIDAR_ANS_SCAN, NULL, 0);
+  appendPackages(stream, packages);
+}
+
+inline void appendLidarStream(std::vector<uint8_t> &stream, uint32_t packets) {
+  std::vector<gs2_node_package> packages;
+  makePackages(packages, packets);
+  appendLidarStream(stream, packages);
+}
+
+/// 按串口典型读取大小分块保存
+inline bool writeRecording(const std::string &path,
+                           const std::vector<uint8_t> &stream) {
+  SerialRecorder recorder;
+
+  if (!recorder.open(path, Baudrate)) {
+    return false;
+  }
+
+  const size_t chunk = 4 * NORMAL_PACKAGE_SIZE;
+
+  for (size_t offset = 0; offset < stream.size(); offset += chunk) {
+    recorder.write(&stream[offset], std::min(chunk, stream.size() - offset));
+  }
+
+  recorder.close();
+  return true;
+}
+
+#if defined(YDLIDAR_TEST_COUNT_ALLOCATIONS)
+/// 当前线程是否计数, 采集线程的分配不计入
+thread_local bool countAllocations = false;
+/// 当前线程计数的分配次数
+thread_local uint64_t allocations = 0;
+
+/*!
+* 全局分配函数统一用malloc/free实现并计数 \n
+* 不内联, 避免编译器把new表达式与free直接配对(-Wmismatched-new-delete)
+*/
+__attribute__((noinline)) void *countedMalloc(size_t size) noexcept {
+  if (countAllocations) {
+    allocations++;
+  }
+
+  return malloc(size ? size : 1);
+}
+
+__attribute__((noinline)) void countedFree(void *ptr) noexcept {
+  free(ptr);
+}
+#endif
+
+}// namespace test
+}// namespace ydlidar
+
+#if defined(YDLIDAR_TEST_COUNT_ALLOCATIONS)
+void *operator new(size_t size) {
+  void *ptr = ydlidar::test::countedMalloc(size);
+
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+void *operator new[](size_t size) {
+  return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return ydlidar::test::countedMalloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return ydlidar::test::countedMalloc(size);
+}
+
+void operator delete(void *ptr) noexcept {
+  ydlidar::test::countedFree(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  ydlidar::test::countedFree(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+  ydlidar::test::countedFree(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+  ydlidar::test::countedFree(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  ydlidar::test::countedFree(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  ydlidar::test::countedFree(ptr);
+}
+#endif